@@ -136,13 +136,12 @@ private:
 
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
-        if(engineMove.current_square == -1){
+        if(engineMove.isNull()){
             std::cout << "Engine error: No move found\n";
             return false;
         }
 
         board.makeMove(engineMove);
-        board.updateGameState(engineMove);
 
         std::cout << "Computer played: " << engineMove.toString();
         std::cout << "\n(searched " << engine_->getNodesSearched() << " nodes in " << duration.count() << "ms)\n";
@@ -166,29 +165,28 @@ private:
 
 
         Move inputMove = board.parseMove(input, board.whiteToMove);
-        std::cout << "parsed: from= " << inputMove.current_square << "to= " << inputMove.target_square << "\n";
-        if(inputMove.current_square == -1){
+        std::cout << "parsed: from= " << inputMove.from() << "to= " << inputMove.to() << "\n";
+        if(inputMove.isNull()){
             std::cout << "Invalid move format. \n";
             return false;
         }
 
-        std::vector<Move>legalMoves = board.generateLegalMoves();
+        MoveList legalMoves = board.generateLegalMoves();
         Move actualMove = board.findMatchingMove(legalMoves, inputMove);
-        if(actualMove.current_square == -1){
+        if(actualMove.isNull()){
             std::cout << "Illegal Move!\n";
             return false;
         }
 
         board.makeMove(actualMove);
-        board.updateGameState(actualMove);
         return true;
 
     }
 
     void showLegalMoves(){
-        std::vector<Move> legalMoves = board.generateLegalMoves();
+        MoveList legalMoves = board.generateLegalMoves();
         std::cout << "Legal moves (" << legalMoves.size() << "): ";
-        for(size_t i = 0; i < legalMoves.size(); i++){
+        for(int i = 0; i < legalMoves.size(); i++){
             std::cout << legalMoves[i].toString();
             if(i < legalMoves.size()-1){
                 std::cout << ", ";
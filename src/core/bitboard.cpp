@@ -0,0 +1,176 @@
+#include "bitboard.hpp"
+#include "utils.hpp"
+
+namespace Bitboards {
+
+Bitboard KNIGHT_ATTACKS[64];
+Bitboard KING_ATTACKS[64];
+Bitboard PAWN_ATTACKS[2][64];
+Bitboard RAYS[8][64];
+Bitboard BETWEEN[64][64];
+Bitboard LINE[64][64];
+
+Magic ROOK_MAGICS[64];
+Magic BISHOP_MAGICS[64];
+
+// shared attack storage, sized for the full 2^bits subsets of every mask
+static Bitboard ROOK_TABLE[102400];
+static Bitboard BISHOP_TABLE[5248];
+
+static const int ROOK_DIRS[4] = {0, 2, 4, 6};
+static const int BISHOP_DIRS[4] = {1, 3, 5, 7};
+
+// file and rank steps for N, NE, E, SE, S, SW, W, NW
+static const int RAY_FILE_STEP[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+static const int RAY_RANK_STEP[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+
+// rays that run towards higher square indices, blockers are found with lsb()
+static bool isPositiveRay(int dir) {
+    return dir == 0 || dir == 1 || dir == 2 || dir == 7;
+}
+
+static Bitboard stepBB(int sq, int fileStep, int rankStep) {
+    int f = file(sq) + fileStep;
+    int r = rank(sq) + rankStep;
+    if(f < 0 || f > 7 || r < 0 || r > 7) return 0;
+    return squareBB(r * 8 + f);
+}
+
+static Bitboard rayAttacks(int sq, Bitboard occupied, int dir) {
+    Bitboard attacks = RAYS[dir][sq];
+    Bitboard blockers = attacks & occupied;
+    if(blockers){
+        int blocker = isPositiveRay(dir) ? lsb(blockers) : msb(blockers);
+        attacks ^= RAYS[dir][blocker];
+    }
+    return attacks;
+}
+
+// reference ray walk, only used to fill the lookup tables
+static Bitboard slidingAttacks(int sq, Bitboard occupied, const int dirs[4]) {
+    Bitboard attacks = 0;
+    for(int i = 0; i < 4; i++){
+        attacks |= rayAttacks(sq, occupied, dirs[i]);
+    }
+    return attacks;
+}
+
+// candidate magics with few set bits are far more likely to work
+static Bitboard sparseRandom(uint64_t& state) {
+    return nextRandom(state) & nextRandom(state) & nextRandom(state);
+}
+
+static void initMagics(Magic magics[64], Bitboard* table, const int dirs[4]) {
+    static Bitboard occupancy[4096];
+    static Bitboard reference[4096];
+    // a slot is current when its epoch matches the attempt; both outlive the call so the
+    // bishop pass can't mistake slots left by the rook pass for its own
+    static int epoch[4096];
+    static int attempt = 0;
+    // per-rank seeds known to converge quickly with this generator
+    static const uint64_t seeds[8] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+    Bitboard* next = table;
+
+    for(int sq = 0; sq < 64; sq++){
+        Magic& m = magics[sq];
+
+        // blockers on the board edge never change the attack set
+        Bitboard edges = ((RANK_1 | RANK_8) & ~(RANK_1 << (8 * rank(sq))))
+                       | ((FILE_A | FILE_H) & ~(FILE_A << file(sq)));
+        m.mask = slidingAttacks(sq, 0, dirs) & ~edges;
+        m.shift = 64 - popCount(m.mask);
+        m.attacks = next;
+
+        // enumerate every subset of the mask (Carry-Rippler)
+        int size = 0;
+        Bitboard subset = 0;
+        do {
+            occupancy[size] = subset;
+            reference[size] = slidingAttacks(sq, subset, dirs);
+            size++;
+            subset = (subset - m.mask) & m.mask;
+        } while(subset);
+        next += size;
+
+#ifdef USE_PEXT
+        m.magic = 0;
+        for(int i = 0; i < size; i++){
+            m.attacks[m.index(occupancy[i])] = reference[i];
+        }
+#else
+        // try candidates until every subset maps to a slot holding its own attack set
+        uint64_t state = seeds[rank(sq)];
+        bool found = false;
+        while(!found){
+            do {
+                m.magic = sparseRandom(state);
+            } while(popCount((m.mask * m.magic) >> 56) < 6);
+
+            attempt++;
+            found = true;
+            for(int i = 0; i < size; i++){
+                unsigned idx = m.index(occupancy[i]);
+                if(epoch[idx] < attempt){
+                    epoch[idx] = attempt;
+                    m.attacks[idx] = reference[i];
+                }
+                else if(m.attacks[idx] != reference[i]){
+                    found = false;
+                    break;
+                }
+            }
+        }
+#endif
+    }
+}
+
+void init() {
+    const int knightSteps[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+
+    for(int sq = 0; sq < 64; sq++){
+        KNIGHT_ATTACKS[sq] = 0;
+        KING_ATTACKS[sq] = 0;
+
+        for(const auto& step : knightSteps){
+            KNIGHT_ATTACKS[sq] |= stepBB(sq, step[0], step[1]);
+        }
+        for(int dir = 0; dir < 8; dir++){
+            KING_ATTACKS[sq] |= stepBB(sq, RAY_FILE_STEP[dir], RAY_RANK_STEP[dir]);
+        }
+
+        PAWN_ATTACKS[0][sq] = stepBB(sq, -1, 1) | stepBB(sq, 1, 1);
+        PAWN_ATTACKS[1][sq] = stepBB(sq, -1, -1) | stepBB(sq, 1, -1);
+
+        for(int dir = 0; dir < 8; dir++){
+            RAYS[dir][sq] = 0;
+            int f = file(sq) + RAY_FILE_STEP[dir];
+            int r = rank(sq) + RAY_RANK_STEP[dir];
+            while(f >= 0 && f <= 7 && r >= 0 && r <= 7){
+                RAYS[dir][sq] |= squareBB(r * 8 + f);
+                f += RAY_FILE_STEP[dir];
+                r += RAY_RANK_STEP[dir];
+            }
+        }
+    }
+
+    // every square along a ray shares that ray's line, the opposite ray completes it
+    for(int sq = 0; sq < 64; sq++){
+        for(int dir = 0; dir < 8; dir++){
+            Bitboard line = RAYS[dir][sq] | RAYS[(dir + 4) % 8][sq] | squareBB(sq);
+            Bitboard targets = RAYS[dir][sq];
+            while(targets){
+                int target = popLsb(targets);
+                BETWEEN[sq][target] = (RAYS[dir][sq] ^ RAYS[dir][target]) & ~squareBB(target);
+                LINE[sq][target] = line;
+            }
+        }
+    }
+
+    initMagics(ROOK_MAGICS, ROOK_TABLE, ROOK_DIRS);
+    initMagics(BISHOP_MAGICS, BISHOP_TABLE, BISHOP_DIRS);
+}
+
+// filled during static initialisation, ready by the time main() runs
+static const bool tablesReady = (init(), true);
+
+} // namespace Bitboards
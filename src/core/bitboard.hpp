@@ -0,0 +1,114 @@
+#pragma once
+#include <cstdint>
+
+#ifdef USE_PEXT
+#include <immintrin.h>
+#endif
+
+// bitboard.hpp - 64-bit square sets and precomputed attack tables
+// bit n of a Bitboard corresponds to board square n (a1 = 0, h8 = 63)
+
+typedef uint64_t Bitboard;
+
+namespace Bitboards {
+
+    constexpr Bitboard FILE_A = 0x0101010101010101ULL;
+    constexpr Bitboard FILE_H = FILE_A << 7;
+    constexpr Bitboard RANK_1 = 0xFFULL;
+    constexpr Bitboard RANK_2 = RANK_1 << 8;
+    constexpr Bitboard RANK_4 = RANK_1 << 24;
+    constexpr Bitboard RANK_5 = RANK_1 << 32;
+    constexpr Bitboard RANK_7 = RANK_1 << 48;
+    constexpr Bitboard RANK_8 = RANK_1 << 56;
+
+    // Leaper attack tables, filled by init()
+    extern Bitboard KNIGHT_ATTACKS[64];
+    extern Bitboard KING_ATTACKS[64];
+    extern Bitboard PAWN_ATTACKS[2][64];    // [white, black] squares a pawn on sq attacks
+
+    // Sliding rays, indexed by direction (N, NE, E, SE, S, SW, W, NW) then square
+    extern Bitboard RAYS[8][64];
+
+    // For two squares on a common rank, file or diagonal: BETWEEN holds the squares
+    // strictly between them, LINE the whole line through both. Empty otherwise.
+    extern Bitboard BETWEEN[64][64];
+    extern Bitboard LINE[64][64];
+
+    // Slider attack lookup for one square. mask holds the relevant blocker squares
+    // (board edges excluded), and the occupancy is hashed into attacks[] either by
+    // magic multiplication or, with USE_PEXT, by extracting the masked bits directly.
+    struct Magic {
+        Bitboard mask;
+        Bitboard magic;
+        Bitboard* attacks;
+        int shift;
+
+        unsigned index(Bitboard occupied) const {
+#ifdef USE_PEXT
+            return static_cast<unsigned>(_pext_u64(occupied, mask));
+#else
+            return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+#endif
+        }
+    };
+
+    extern Magic ROOK_MAGICS[64];
+    extern Magic BISHOP_MAGICS[64];
+
+    void init();
+
+    inline Bitboard squareBB(int sq) {
+        return 1ULL << sq;
+    }
+
+    inline int popCount(Bitboard b) {
+        return __builtin_popcountll(b);
+    }
+
+    // index of the lowest set bit, b must be non-zero
+    inline int lsb(Bitboard b) {
+        return __builtin_ctzll(b);
+    }
+
+    // index of the highest set bit, b must be non-zero
+    inline int msb(Bitboard b) {
+        return 63 - __builtin_clzll(b);
+    }
+
+    inline int popLsb(Bitboard& b) {
+        int sq = lsb(b);
+        b &= b - 1;
+        return sq;
+    }
+
+    // squares attacked by a set of pawns, side 0 for white and 1 for black
+    inline Bitboard pawnAttacks(Bitboard pawns, int side) {
+        if(side == 0){
+            return ((pawns & ~FILE_A) << 7) | ((pawns & ~FILE_H) << 9);
+        }
+        return ((pawns & ~FILE_A) >> 9) | ((pawns & ~FILE_H) >> 7);
+    }
+
+    // xorshift64* step, shared by the magic search and the Zobrist keys. Both start from
+    // a fixed seed, so their tables come out the same on every run.
+    inline uint64_t nextRandom(uint64_t& state) {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+
+    inline Bitboard rookAttacks(int sq, Bitboard occupied) {
+        const Magic& m = ROOK_MAGICS[sq];
+        return m.attacks[m.index(occupied)];
+    }
+
+    inline Bitboard bishopAttacks(int sq, Bitboard occupied) {
+        const Magic& m = BISHOP_MAGICS[sq];
+        return m.attacks[m.index(occupied)];
+    }
+
+    inline Bitboard queenAttacks(int sq, Bitboard occupied) {
+        return rookAttacks(sq, occupied) | bishopAttacks(sq, occupied);
+    }
+}
@@ -2,9 +2,11 @@
 #include "utils.hpp"
 #include "move.hpp"
 #include "moveGen.hpp"
-#include "utils.hpp"
+#include "zobrist.hpp"
+#include "../engine/piece_tables.hpp"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
-#include <vector>
 
 
 std::string EnumToChar(int square){
@@ -43,6 +45,121 @@ Board::Board() {
     squares.fill(EMPTY);
 }
 
+void Board::putPiece(int square, int piece){
+    Bitboard bb = Bitboards::squareBB(square);
+    squares[square] = piece;
+    hashKey ^= Zobrist::PIECE_SQUARE[piece][square];
+    if(isPawn(piece)) pawnKey ^= Zobrist::PIECE_SQUARE[piece][square];
+    mgScore += PieceSquareTables::PSQT_MG[piece][square];
+    egScore += PieceSquareTables::PSQT_EG[piece][square];
+    phase += PieceSquareTables::GAME_PHASE_INC[piece];
+    pieceBB[piece] |= bb;
+    colourBB[pieceColour(piece)] |= bb;
+    occupied |= bb;
+}
+
+void Board::removePiece(int square){
+    int piece = squares[square];
+    if(piece == EMPTY) return;
+
+    Bitboard bb = Bitboards::squareBB(square);
+    squares[square] = EMPTY;
+    hashKey ^= Zobrist::PIECE_SQUARE[piece][square];
+    if(isPawn(piece)) pawnKey ^= Zobrist::PIECE_SQUARE[piece][square];
+    mgScore -= PieceSquareTables::PSQT_MG[piece][square];
+    egScore -= PieceSquareTables::PSQT_EG[piece][square];
+    phase -= PieceSquareTables::GAME_PHASE_INC[piece];
+    pieceBB[piece] &= ~bb;
+    colourBB[pieceColour(piece)] &= ~bb;
+    occupied &= ~bb;
+}
+
+void Board::movePiece(int from, int to){
+    int piece = squares[from];
+    Bitboard fromTo = Bitboards::squareBB(from) | Bitboards::squareBB(to);
+    squares[to] = piece;
+    squares[from] = EMPTY;
+    hashKey ^= Zobrist::PIECE_SQUARE[piece][from] ^ Zobrist::PIECE_SQUARE[piece][to];
+    if(isPawn(piece)) pawnKey ^= Zobrist::PIECE_SQUARE[piece][from] ^ Zobrist::PIECE_SQUARE[piece][to];
+    mgScore += PieceSquareTables::PSQT_MG[piece][to] - PieceSquareTables::PSQT_MG[piece][from];
+    egScore += PieceSquareTables::PSQT_EG[piece][to] - PieceSquareTables::PSQT_EG[piece][from];
+    pieceBB[piece] ^= fromTo;
+    colourBB[pieceColour(piece)] ^= fromTo;
+    occupied ^= fromTo;
+}
+
+void Board::refreshBitboards(){
+    pieceBB.fill(0);
+    colourBB.fill(0);
+    occupied = 0;
+    hashKey = pawnKey = 0;
+    mgScore = egScore = phase = 0;
+
+    // putPiece hashes the pieces in, the state keys are added on top
+    for(int sq = 0; sq < 64; sq++){
+        if(squares[sq] != EMPTY){
+            putPiece(sq, squares[sq]);
+        }
+    }
+    if(!whiteToMove) hashKey ^= Zobrist::SIDE;
+    hashKey ^= Zobrist::CASTLING_RIGHTS[castlingMask()] ^ enPassantKey();
+}
+
+uint64_t Board::enPassantKey() const{
+    return enPassantSquare == -1 ? 0 : Zobrist::EN_PASSANT_FILE[file(enPassantSquare)];
+}
+
+uint64_t Board::computeHash() const{
+    uint64_t key = 0;
+    for(int sq = 0; sq < 64; sq++){
+        if(squares[sq] != EMPTY){
+            key ^= Zobrist::PIECE_SQUARE[squares[sq]][sq];
+        }
+    }
+    if(!whiteToMove) key ^= Zobrist::SIDE;
+    return key ^ Zobrist::CASTLING_RIGHTS[castlingMask()] ^ enPassantKey();
+}
+
+uint64_t Board::computePawnKey() const{
+    uint64_t key = 0;
+    for(int sq = 0; sq < 64; sq++){
+        if(isPawn(squares[sq])){
+            key ^= Zobrist::PIECE_SQUARE[squares[sq]][sq];
+        }
+    }
+    return key;
+}
+
+void Board::computeEvalTerms(int& mg, int& eg, int& gamePhase) const{
+    mg = eg = gamePhase = 0;
+    for(int sq = 0; sq < 64; sq++){
+        int piece = squares[sq];
+        if(piece == EMPTY) continue;
+        mg += PieceSquareTables::PSQT_MG[piece][sq];
+        eg += PieceSquareTables::PSQT_EG[piece][sq];
+        gamePhase += PieceSquareTables::GAME_PHASE_INC[piece];
+    }
+}
+
+// debug builds (CHESS_DEBUG_INCREMENTAL) compare incremental state against a full recompute
+void Board::verifyIncrementalState() const{
+    if(hashKey != computeHash()){
+        std::cerr << "incremental hash mismatch in " << toFEN() << "\n";
+        std::abort();
+    }
+    if(pawnKey != computePawnKey()){
+        std::cerr << "incremental pawn hash mismatch in " << toFEN() << "\n";
+        std::abort();
+    }
+
+    int mg, eg, gamePhase;
+    computeEvalTerms(mg, eg, gamePhase);
+    if(mg != mgScore || eg != egScore || gamePhase != phase){
+        std::cerr << "incremental evaluation mismatch in " << toFEN() << "\n";
+        std::abort();
+    }
+}
+
 void Board::setStartPos() {
     squares.fill(EMPTY);
 
@@ -85,6 +202,152 @@ void Board::setStartPos() {
     Board::halfmoveClock = 0;
     Board::enPassantSquare = -1;
     Board::whiteToMove = true;
+    refreshBitboards();
+}
+
+const char* fenErrorString(FenError error){
+    switch(error){
+        case FEN_OK:                return "ok";
+        case FEN_BAD_PLACEMENT:     return "bad piece placement";
+        case FEN_BAD_KINGS:         return "each side needs exactly one king";
+        case FEN_BAD_PAWNS:         return "pawn on the first or last rank";
+        case FEN_BAD_SIDE:          return "side to move must be w or b";
+        case FEN_BAD_CASTLING:      return "bad castling field";
+        case FEN_BAD_EN_PASSANT:    return "bad en passant square";
+        case FEN_BAD_CLOCKS:        return "bad move clocks";
+        case FEN_BAD_CHECK:         return "side not to move is in check";
+    }
+    return "unknown error";
+}
+
+static int pieceFromChar(char c){
+    switch(c){
+        case 'p': return B_PAWN;
+        case 'n': return B_KNIGHT;
+        case 'b': return B_BISHOP;
+        case 'r': return B_ROOK;
+        case 'q': return B_QUEEN;
+        case 'k': return B_KING;
+        case 'P': return W_PAWN;
+        case 'N': return W_KNIGHT;
+        case 'B': return W_BISHOP;
+        case 'R': return W_ROOK;
+        case 'Q': return W_QUEEN;
+        case 'K': return W_KING;
+    }
+    return EMPTY;
+}
+
+// splits off the next space separated field, empty once the input runs out
+static std::string_view nextField(std::string_view& fen){
+    size_t start = fen.find_first_not_of(' ');
+    if(start == std::string_view::npos){
+        fen = {};
+        return {};
+    }
+    fen.remove_prefix(start);
+    size_t end = std::min(fen.find(' '), fen.size());
+    std::string_view field = fen.substr(0, end);
+    fen.remove_prefix(end);
+    return field;
+}
+
+static bool parseClock(std::string_view field, int& value){
+    if(field.empty() || field.size() > 6) return false;
+    value = 0;
+    for(char c : field){
+        if(c < '0' || c > '9') return false;
+        value = value * 10 + (c - '0');
+    }
+    return true;
+}
+
+// Validating FEN reader. The clocks may be left off (EPD style) and default to 0 and 1.
+// On error the board is left as it was.
+FenError Board::fromFEN(std::string_view fen){
+    Board b;
+    b.castlingrights = {false, false, false, false};
+
+    // placement, rank 8 first
+    std::string_view placement = nextField(fen);
+    int rank = 7, file = 0;
+    int whiteKings = 0, blackKings = 0;
+    bool pawnOnEdge = false;
+    for(char c : placement){
+        if(c == '/'){
+            if(file != 8 || rank == 0) return FEN_BAD_PLACEMENT;
+            rank--;
+            file = 0;
+        }
+        else if(c >= '1' && c <= '8'){
+            file += c - '0';
+            if(file > 8) return FEN_BAD_PLACEMENT;
+        }
+        else{
+            int piece = pieceFromChar(c);
+            if(piece == EMPTY || file > 7) return FEN_BAD_PLACEMENT;
+            if(piece == W_KING) whiteKings++;
+            if(piece == B_KING) blackKings++;
+            if((piece == W_PAWN || piece == B_PAWN) && (rank == 0 || rank == 7)) pawnOnEdge = true;
+            b.squares[rank * 8 + file++] = piece;
+        }
+    }
+    if(rank != 0 || file != 8) return FEN_BAD_PLACEMENT;
+    if(whiteKings != 1 || blackKings != 1) return FEN_BAD_KINGS;
+    if(pawnOnEdge) return FEN_BAD_PAWNS;
+
+    std::string_view side = nextField(fen);
+    if(side != "w" && side != "b") return FEN_BAD_SIDE;
+    b.whiteToMove = side == "w";
+
+    std::string_view castling = nextField(fen);
+    if(castling.empty()) return FEN_BAD_CASTLING;
+    if(castling != "-"){
+        for(char c : castling){
+            bool* right = c == 'K' ? &b.castlingrights.W_KingSide
+                        : c == 'Q' ? &b.castlingrights.W_QueenSide
+                        : c == 'k' ? &b.castlingrights.B_KingSide
+                        : c == 'q' ? &b.castlingrights.B_QueenSide : nullptr;
+            if(!right || *right) return FEN_BAD_CASTLING;
+            *right = true;
+        }
+    }
+    // a right without its king and rook at home can never be used; dropping it keeps one
+    // hash per position and lets toFEN reproduce the field
+    bool whiteKingHome = b.squares[4] == W_KING, blackKingHome = b.squares[60] == B_KING;
+    b.castlingrights.W_KingSide &= whiteKingHome && b.squares[7] == W_ROOK;
+    b.castlingrights.W_QueenSide &= whiteKingHome && b.squares[0] == W_ROOK;
+    b.castlingrights.B_KingSide &= blackKingHome && b.squares[63] == B_ROOK;
+    b.castlingrights.B_QueenSide &= blackKingHome && b.squares[56] == B_ROOK;
+
+    // the target square sits behind a pawn that has just made a double push, and both
+    // squares it crossed are empty
+    std::string_view enPassant = nextField(fen);
+    if(enPassant.empty()) return FEN_BAD_EN_PASSANT;
+    if(enPassant != "-"){
+        if(enPassant.size() != 2 || enPassant[0] < 'a' || enPassant[0] > 'h') return FEN_BAD_EN_PASSANT;
+        if(enPassant[1] != (b.whiteToMove ? '6' : '3')) return FEN_BAD_EN_PASSANT;
+        int sq = (enPassant[0] - 'a') + (enPassant[1] - '1') * 8;
+        int pushed = b.whiteToMove ? sq - 8 : sq + 8;
+        int start = b.whiteToMove ? sq + 8 : sq - 8;
+        if(b.squares[pushed] != (b.whiteToMove ? B_PAWN : W_PAWN)) return FEN_BAD_EN_PASSANT;
+        if(b.squares[sq] != EMPTY || b.squares[start] != EMPTY) return FEN_BAD_EN_PASSANT;
+        b.enPassantSquare = sq;
+    }
+
+    std::string_view halfmoves = nextField(fen);
+    if(!halfmoves.empty()){
+        std::string_view fullmoves = nextField(fen);
+        if(!parseClock(halfmoves, b.halfmoveClock)) return FEN_BAD_CLOCKS;
+        if(!parseClock(fullmoves, b.fullMoveNumber) || b.fullMoveNumber == 0) return FEN_BAD_CLOCKS;
+    }
+    if(!nextField(fen).empty()) return FEN_BAD_CLOCKS;
+
+    b.refreshBitboards();
+    // the king could be captured, move generation assumes that never happens
+    if(b.isSquareAttacked(b.findking(!b.whiteToMove), b.whiteToMove)) return FEN_BAD_CHECK;
+    *this = b;
+    return FEN_OK;
 }
 
 void Board::print(bool white) const {
@@ -116,24 +379,48 @@ void Board::print(bool white) const {
 }
 
 
+UndoInfo Board::makeNullMove(){
+    UndoInfo undo;
+    undo.captured = EMPTY;
+    undo.castlingrights = castlingrights;
+    undo.enPassantSquare = enPassantSquare;
+    undo.halfmoveClock = halfmoveClock;
+    undo.hashKey = hashKey;
+
+    hashKey ^= enPassantKey() ^ Zobrist::SIDE;
+    enPassantSquare = -1;
+    halfmoveClock++;
+    whiteToMove = !whiteToMove;
+
+#ifdef CHESS_DEBUG_INCREMENTAL
+    verifyIncrementalState();
+#endif
+    return undo;
+}
+
+void Board::unmakeNullMove(const UndoInfo& undo){
+    whiteToMove = !whiteToMove;
+    enPassantSquare = undo.enPassantSquare;
+    halfmoveClock = undo.halfmoveClock;
+    hashKey = undo.hashKey;
+}
+
 void Board::updateGameState(const Move& move){
-    UpdateCastlingRights(const_cast<Move&>(move));
+    UpdateCastlingRights(move);
 
 
-    // needs to fixed, currently never takes any condition
     enPassantSquare = -1;
-    if(move.flags == DOUBLE_PAWN_PUSH){
-        if(squares[move.target_square] == W_PAWN){
-            enPassantSquare = move.target_square - 8;
+    if(move.isDoublePawnPush()){
+        if(squares[move.to()] == W_PAWN){
+            enPassantSquare = move.to() - 8;
         }
-        else if(squares[move.target_square] == B_PAWN){
-            enPassantSquare = move.target_square + 8;
+        else if(squares[move.to()] == B_PAWN){
+            enPassantSquare = move.to() + 8;
         }
     }
 
-    if(move.flags & CAPTURE || move.flags == EN_PASSANT ||
-        squares[move.target_square] == W_PAWN || squares[move.target_square] == B_PAWN ||
-        move.flags & PROMOTION || move.flags & CAPTURE_N_PROMOTION){
+    if(move.isCapture() || move.isPromotion() ||
+        squares[move.to()] == W_PAWN || squares[move.to()] == B_PAWN){
         halfmoveClock = 0;
     }
     else{
@@ -147,14 +434,8 @@ void Board::updateGameState(const Move& move){
 }
 
 int Board::findking(bool white) const{
-    int targetKing = white ? W_KING : B_KING;
-
-    for(int i = 0; i < 64; i++){
-        if(squares[i] == targetKing){
-            return i;
-        }
-    }
-    return -1;
+    Bitboard king = pieceBB[white ? W_KING : B_KING];
+    return king ? Bitboards::lsb(king) : -1;
 }
 
 bool Board::isCheck(bool white) const{
@@ -164,20 +445,10 @@ bool Board::isCheck(bool white) const{
     return isSquareAttacked(kingSquare, !white);
 }
 
-std::vector<Move> Board::generateLegalMoves(){
-    std::vector<Move> pseudoLegalMoves = MoveGen::GenPseudoLegal(*this, whiteToMove);
-    std::vector<Move> legalMoves;
-
-    for(auto& move : pseudoLegalMoves){
-        Board testBoard = *this;
-        testBoard.makeMove(move);
-
-        if(!testBoard.isCheck(whiteToMove)){
-            legalMoves.push_back(move);
-        }
-    }
-    return legalMoves;
-
+MoveList Board::generateLegalMoves() const{
+    MoveList moves;
+    MoveGen::GenLegal(*this, moves);
+    return moves;
 }
 
 bool Board::isCheckmate(){
@@ -227,10 +498,14 @@ std::string Board::toFEN() const{
     fen += " ";
     std::string castling = "";
 
-    if(castlingrights.W_KingSide) castling += "K";
-    if(castlingrights.W_QueenSide) castling += "Q";
-    if(castlingrights.B_KingSide) castling += "k";
-    if(castlingrights.B_QueenSide) castling += "q";
+    // a right is only written while its king and rook are still on their home squares,
+    // so positions edited square by square still produce a consistent FEN
+    bool whiteKingHome = squares[4] == W_KING;
+    bool blackKingHome = squares[60] == B_KING;
+    if(castlingrights.W_KingSide && whiteKingHome && squares[7] == W_ROOK) castling += "K";
+    if(castlingrights.W_QueenSide && whiteKingHome && squares[0] == W_ROOK) castling += "Q";
+    if(castlingrights.B_KingSide && blackKingHome && squares[63] == B_ROOK) castling += "k";
+    if(castlingrights.B_QueenSide && blackKingHome && squares[56] == B_ROOK) castling += "q";
     if(castling.empty()) castling = "-";
     fen += castling;
 
@@ -258,119 +533,131 @@ std::string Board::toFEN() const{
 
 
 
-// need to make CAPTURE + PROMOTION simultaneous  logic
-void Board::makeMove(Move& m){
+UndoInfo Board::makeMove(const Move& m){
+    int from = m.from();
+    int to = m.to();
 
-    // Piece is being transferred to a new square, so target_square <- current_square for a piece moving 
-    // from one square to another
+    UndoInfo undo;
+    undo.captured = capturedPiece(m);
+    undo.castlingrights = castlingrights;
+    undo.enPassantSquare = enPassantSquare;
+    undo.halfmoveClock = halfmoveClock;
+    undo.hashKey = hashKey;
+    int oldCastling = castlingMask();
 
-    // normal moves - Flag = QUIET
+    // captured piece leaves first, en passant takes the pawn behind the target square
+    if(m.isEnPassant()){
+        removePiece(whiteToMove ? to - 8 : to + 8);
+    }
+    else if(m.isCapture()){
+        removePiece(to);
+    }
 
-    switch (m.flags) {
-        case QUIET:
-            squares[m.target_square] = squares[m.current_square];
-            squares[m.current_square] = EMPTY;
-            break;
-        
-        case DOUBLE_PAWN_PUSH:
-            squares[m.target_square] = squares[m.current_square];
-            squares[m.current_square] = EMPTY;
-            break;
-
-        case CAPTURE:
-            squares[m.target_square] = squares[m.current_square];
-            squares[m.current_square] = EMPTY;
-            break;
-
-        case EN_PASSANT:
-            squares[m.target_square] = squares[m.current_square];
-            squares[m.current_square] = EMPTY;
-            if(squares[m.target_square] == W_PAWN){
-                squares[m.target_square - 8] = EMPTY;
-            }
-            else{
-                squares[m.target_square + 8] = EMPTY;
-            }
-            break;
+    if(m.isPromotion()){
+        removePiece(from);
+        putPiece(to, makePiece(whiteToMove ? WHITE : BLACK, m.promotionType()));
+    }
+    else{
+        movePiece(from, to);
+    }
 
-        case PROMOTION:
-            if(squares[m.current_square] == W_PAWN){
-                squares[m.target_square] = W_QUEEN;          //to be changed - call a function to let player decide promotion piece
-                squares[m.current_square] = EMPTY;
-            }
-            else{
-                squares[m.target_square] = B_QUEEN;
-                squares[m.current_square] = EMPTY;
-            }
-            break;
-        
-        case CASTLING:
-            if(m.target_square == 2){
-                squares[m.target_square] = W_KING;
-                squares[3] = W_ROOK;
-                squares[m.current_square] = EMPTY;
-                squares[0] = EMPTY;
+    // the king has already moved, bring the rook across
+    if(m.isCastling()){
+        switch (to) {
+            case 2:
+                movePiece(0, 3);
                 castlingrights.W_KingSide = castlingrights.W_QueenSide = false;
-            }
-            else if(m.target_square == 6){
-                squares[m.target_square] = W_KING;
-                squares[5] = W_ROOK;
-                squares[m.current_square] = EMPTY;
-                squares[7] = EMPTY;  
+                break;
+            case 6:
+                movePiece(7, 5);
                 castlingrights.W_KingSide = castlingrights.W_QueenSide = false;
-
-            }
-            else if(m.target_square == 58){
-                squares[m.target_square] = B_KING;
-                squares[59] = B_ROOK;
-                squares[m.current_square] = EMPTY;
-                squares[56] = EMPTY;
+                break;
+            case 58:
+                movePiece(56, 59);
                 castlingrights.B_KingSide = castlingrights.B_QueenSide = false;
-            }
-            else if(m.target_square == 62){
-                squares[m.target_square] = B_KING;
-                squares[61] = B_ROOK;
-                squares[m.current_square] = EMPTY;
-                squares[63] = EMPTY;
+                break;
+            case 62:
+                movePiece(63, 61);
                 castlingrights.B_KingSide = castlingrights.B_QueenSide = false;
-            }
-            break;
+                break;
+        }
+    }
 
-        case CAPTURE_N_PROMOTION:
-            squares[m.target_square] = squares[m.current_square];
-            squares[m.current_square] = EMPTY;
-            if(squares[m.target_square] == W_PAWN){
-                squares[m.target_square] = W_QUEEN;        //needs promotion choice
-            }
-            else {
-                squares[m.target_square] = B_QUEEN;        //needs promotion choice
-            }
-            break;
+    updateGameState(m);
+    // rehash only the state updateGameState changed
+    hashKey ^= Zobrist::CASTLING_RIGHTS[oldCastling ^ castlingMask()] ^ Zobrist::SIDE;
+    if(undo.enPassantSquare != -1) hashKey ^= Zobrist::EN_PASSANT_FILE[file(undo.enPassantSquare)];
+    if(enPassantSquare != -1) hashKey ^= Zobrist::EN_PASSANT_FILE[file(enPassantSquare)];
+
+#ifdef CHESS_DEBUG_INCREMENTAL
+    verifyIncrementalState();
+#endif
+    return undo;
+}
+
+void Board::unmakeMove(const Move& m, const UndoInfo& undo){
+    int from = m.from();
+    int to = m.to();
+
+    whiteToMove = !whiteToMove;
+    if(!whiteToMove) fullMoveNumber--;
+
+    castlingrights = undo.castlingrights;
+    enPassantSquare = undo.enPassantSquare;
+    halfmoveClock = undo.halfmoveClock;
+
+    if(m.isCastling()){
+        switch (to) {
+            case 2:  movePiece(3, 0);   break;
+            case 6:  movePiece(5, 7);   break;
+            case 58: movePiece(59, 56); break;
+            case 62: movePiece(61, 63); break;
+        }
+    }
 
+    if(m.isPromotion()){
+        removePiece(to);
+        putPiece(from, whiteToMove ? W_PAWN : B_PAWN);
+    }
+    else{
+        movePiece(to, from);
+    }
 
-    }; 
+    if(m.isEnPassant()){
+        putPiece(whiteToMove ? to - 8 : to + 8, undo.captured);
+    }
+    else if(m.isCapture()){
+        putPiece(to, undo.captured);
+    }
+
+    // piece moves above toggled the key, the saved key is the exact original
+    hashKey = undo.hashKey;
 
+#ifdef CHESS_DEBUG_INCREMENTAL
+    verifyIncrementalState();
+#endif
 }
 
 
-// Needs rework to be compliant with current structure
-void Board::UpdateCastlingRights(Move& m){
-    if(squares[m.target_square] == Piece::W_KING){
+// called after the move is on the board: a king or rook leaving its home square, or a
+// rook being captured there, loses the matching rights
+void Board::UpdateCastlingRights(const Move& m){
+    int from = m.from();
+    int to = m.to();
+
+    if(squares[to] == Piece::W_KING){
         castlingrights.W_KingSide = false;
         castlingrights.W_QueenSide = false;
     }
-    if(squares[m.target_square] == Piece::B_KING){
+    if(squares[to] == Piece::B_KING){
         castlingrights.B_KingSide = false;
         castlingrights.B_QueenSide = false;
     }
 
-    if(m.current_square == 4 || m.target_square == 4) castlingrights.W_QueenSide = false; castlingrights.W_KingSide == false;
-    if(m.current_square == 60 || m.target_square == 60) castlingrights.B_KingSide = false; castlingrights.B_QueenSide = false;
-
-    if(m.target_square == 0 || m.current_square == 0) castlingrights.W_KingSide = false;
-    if(m.target_square == 7 || m.current_square == 7) castlingrights.W_QueenSide = false;
-    if(m.target_square == 56 || m.current_square == 56) castlingrights.B_KingSide = false;
-    if(m.target_square == 63 || m.current_square == 63) castlingrights.B_QueenSide = false;
+    if(to == 0 || from == 0) castlingrights.W_QueenSide = false;
+    if(to == 7 || from == 7) castlingrights.W_KingSide = false;
+    if(to == 56 || from == 56) castlingrights.B_QueenSide = false;
+    if(to == 63 || from == 63) castlingrights.B_KingSide = false;
 }
 
 
@@ -393,27 +680,43 @@ int Board::parseSquare(const std::string square, bool whitePerspective){
 }
 
 
+// coordinate move, optionally followed by the promotion piece (e7e8n)
 Move Board::parseMove(const std::string& Move, bool whitePerspective){
-    if(Move.size() != 4) return {-1, -1, EMPTY, EMPTY, 0};
+    if(Move.size() != 4 && Move.size() != 5) return {};
 
     int start = parseSquare(Move.substr(0,2), whitePerspective);
     int end = parseSquare(Move.substr(2,2), whitePerspective);
+    if(start == -1 || end == -1) return {};
+
+    if(Move.size() == 5){
+        switch(Move[4]){
+            case 'n': return {start, end, promotionFlags(KNIGHT, false)};
+            case 'b': return {start, end, promotionFlags(BISHOP, false)};
+            case 'r': return {start, end, promotionFlags(ROOK, false)};
+            case 'q': return {start, end, promotionFlags(QUEEN, false)};
+            default:  return {};
+        }
+    }
 
-    return {start, end, EMPTY, EMPTY, 0};
+    return {start, end};
 }
 
-Move Board::findMatchingMove(const std::vector<Move>& legalMoves, const Move& inputMove){
+// a promotion without a piece given promotes to a queen
+Move Board::findMatchingMove(const MoveList& legalMoves, const Move& inputMove){
+    int promotion = inputMove.isPromotion() ? inputMove.promotionType() : QUEEN;
+
     for(const auto& move : legalMoves){
-        if(move.target_square == inputMove.target_square && move.current_square == inputMove.current_square){
+        if(move.to() == inputMove.to() && move.from() == inputMove.from()){
+            if(move.isPromotion() && move.promotionType() != promotion) continue;
             return move;
         }
     }
-    return {-1, -1, EMPTY, EMPTY, 0};
+    return {};
 }
 
-bool Board::IsMoveLegal(const Move& move, const std::vector<Move>& legalMoves){
+bool Board::IsMoveLegal(const Move& move, const MoveList& legalMoves){
     for(const auto& legalMove : legalMoves){
-        if(legalMove.target_square == move.target_square && legalMove.current_square == move.current_square){
+        if(legalMove.to() == move.to() && legalMove.from() == move.from()){
             return true;
         }
     }
@@ -421,115 +724,32 @@ bool Board::IsMoveLegal(const Move& move, const std::vector<Move>& legalMoves){
 }
 
 
-bool IsWhite(const int piece){
-    return piece == W_BISHOP || piece == W_KING || piece == W_KNIGHT || piece == W_ROOK || piece == W_QUEEN || piece == W_PAWN;
-}
-
-bool IsBlack(const int piece){
-    return piece == B_BISHOP || piece == B_KING || piece == B_KNIGHT || piece == B_ROOK || piece == B_QUEEN || piece == B_PAWN;
-
-}
-
-
 bool Board::isSquareAttacked(int square, bool byWhite) const{
-    // pawn attacks
-    if(byWhite){
-        int target_square = square - 7;
-        if(onBoard(target_square) && file(target_square) == file(square) - 1 && squares[target_square] == W_PAWN) return true;
-        target_square = square - 9;
-        if(onBoard(target_square) && file(target_square) == file(square) + 1 && squares[target_square] == W_PAWN) return true;
-    } 
-    else{
-        int target_square = square + 7;
-        if(onBoard(target_square) && file(target_square) == file(square) + 1 && squares[target_square] == B_PAWN) return true;
-        target_square = square + 9;
-        if(onBoard(target_square) && file(target_square) == file(square) - 1 && squares[target_square] == B_PAWN) return true;
-    }
-
-    // knight
-    const int knighcurrent_squareffsets[8] = {6, -6, 10, -10, 15, -15, 17, -17};
-    for(int d : knighcurrent_squareffsets){
-        int t = square + d;
-        if(!onBoard(t)) continue;
-        int fd = std::abs(file(t) - file(square));
-        int rd = std::abs(rank(t) - rank(square));
-        if(!((fd == 1 && rd == 2) || (fd == 2 && rd == 1))) continue;
-        if((byWhite && squares[t] == W_KNIGHT) || (!byWhite && squares[t] == B_KNIGHT)) return true;
-    }
-
-    
-    auto isAttackerPiece = [&](int p){
-        return byWhite ? IsWhite(p) : IsBlack(p);
-    };
-
-    // rook/queen
-    const int rookDirs[4] = {1, -1, 8, -8};
-    for(int dir : rookDirs){
-        int prev = square;
-        int t = square + dir;
-        while(onBoard(t)){
-            // prevent horizontal wrap
-            if((dir == 1 || dir == -1) && rank(t) != rank(prev)) break;
-
-            int p = squares[t];
-            if(p == EMPTY){
-                prev = t;
-                t += dir;
-                continue;
-            }
-            // if piece belongs current_square attacker
-            if(isAttackerPiece(p)){
-                if ((byWhite && (p == W_ROOK || p == W_QUEEN)) ||
-                    (!byWhite && (p == B_ROOK || p == B_QUEEN)) ){
-                    return true;
-                }
-                break; //blocked by own side
-            } 
-            else{
-                break; 
-            }
-        }
-    }
+    using namespace Bitboards;
+    int attacker = byWhite ? WHITE : BLACK;
 
-    // bishop/queen
-    const int diagDirs[4] = {9, -9, 7, -7};
-    for(int dir : diagDirs){
-        int prev = square;
-        int t = square + dir;
-        while(onBoard(t)){
-            // ensure step is diagonal (file & rank step of 1)
-            if(std::abs(file(t) - file(prev)) != 1 || std::abs(rank(t) - rank(prev)) != 1) break;
-
-            int p = squares[t];
-            if(p == EMPTY){
-                prev = t;
-                t += dir;
-                continue;
-            }
-            if(isAttackerPiece(p)){
-                if ((byWhite && (p == W_BISHOP || p == W_QUEEN)) ||
-                    (!byWhite && (p == B_BISHOP || p == B_QUEEN))){
-                    return true;
-                }
-                break;
-            } 
-            else{
-                break;
-            }
-        }
-    }
+    // a pawn of the defending colour on square attacks exactly the squares an attacking pawn could capture from
+    if(PAWN_ATTACKS[attacker ^ 1][square] & pieces(attacker, PAWN)) return true;
+    if(KNIGHT_ATTACKS[square] & pieces(attacker, KNIGHT)) return true;
+    if(KING_ATTACKS[square] & pieces(attacker, KING)) return true;
 
-    // kings being close 
-    for(int dir : {1, -1, 8, -8, 7, -7, 9, -9}){
-        int t = square + dir;
-        if(!onBoard(t)) continue;
-        int fd = std::abs(file(t) - file(square));
-        int rd = std::abs(rank(t) - rank(square));
-        if(fd <= 1 && rd <= 1){
-            if ((byWhite && squares[t] == W_KING) || (!byWhite && squares[t] == B_KING)) return true;
-        }
-    }
+    Bitboard queens = pieces(attacker, QUEEN);
+    if(rookAttacks(square, occupied) & (pieces(attacker, ROOK) | queens)) return true;
+    if(bishopAttacks(square, occupied) & (pieces(attacker, BISHOP) | queens)) return true;
 
     return false;
 }
 
+// every piece attacking square, with sliders blocked by the given occupancy
+Bitboard Board::attackersTo(int square, Bitboard occupancy) const{
+    using namespace Bitboards;
+    Bitboard rooksQueens = pieceBB[W_ROOK] | pieceBB[B_ROOK] | pieceBB[W_QUEEN] | pieceBB[B_QUEEN];
+    Bitboard bishopsQueens = pieceBB[W_BISHOP] | pieceBB[B_BISHOP] | pieceBB[W_QUEEN] | pieceBB[B_QUEEN];
+
+    return (PAWN_ATTACKS[BLACK][square] & pieceBB[W_PAWN])
+         | (PAWN_ATTACKS[WHITE][square] & pieceBB[B_PAWN])
+         | (KNIGHT_ATTACKS[square] & (pieceBB[W_KNIGHT] | pieceBB[B_KNIGHT]))
+         | (KING_ATTACKS[square] & (pieceBB[W_KING] | pieceBB[B_KING]))
+         | (rookAttacks(square, occupancy) & rooksQueens)
+         | (bishopAttacks(square, occupancy) & bishopsQueens);
+}
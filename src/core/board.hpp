@@ -1,8 +1,9 @@
 #pragma once
 #include "move.hpp"
+#include "bitboard.hpp"
 #include <array>
 #include <string>
-#include <vector>
+#include <string_view>
 
 enum Piece{
     EMPTY = 0,
@@ -10,6 +11,42 @@ enum Piece{
     W_PAWN, W_KNIGHT, W_BISHOP, W_ROOK, W_QUEEN, W_KING,
 };
 
+enum Colour { WHITE = 0, BLACK = 1 };
+
+enum PieceType { PAWN = 0, KNIGHT, BISHOP, ROOK, QUEEN, KING };
+
+inline int pieceColour(int piece) {
+    return piece >= W_PAWN ? WHITE : BLACK;
+}
+
+inline int makePiece(int colour, int type) {
+    return (colour == WHITE ? W_PAWN : B_PAWN) + type;
+}
+
+// PieceType of a non-empty piece
+inline int pieceType(int piece) {
+    return (piece - 1) % 6;
+}
+
+inline bool isPawn(int piece) {
+    return piece == W_PAWN || piece == B_PAWN;
+}
+
+// result of Board::fromFEN, FEN_OK on success
+enum FenError {
+    FEN_OK = 0,
+    FEN_BAD_PLACEMENT,
+    FEN_BAD_KINGS,
+    FEN_BAD_PAWNS,
+    FEN_BAD_SIDE,
+    FEN_BAD_CASTLING,
+    FEN_BAD_EN_PASSANT,
+    FEN_BAD_CLOCKS,
+    FEN_BAD_CHECK               // the side that just moved is left in check
+};
+
+const char* fenErrorString(FenError error);
+
 struct CastlingRights {
     bool W_KingSide;
     bool W_QueenSide;
@@ -17,36 +54,96 @@ struct CastlingRights {
     bool B_QueenSide;
 };
 
+// state a move destroys, returned by makeMove so unmakeMove can restore it
+struct UndoInfo {
+    int captured;
+    CastlingRights castlingrights;
+    int enPassantSquare;
+    int halfmoveClock;
+    uint64_t hashKey;
+};
+
 class Board {
 public:
     std::array<int, 64> squares{};
+
+    // bitboards mirror squares; squares stays for O(1) "what is on square X" lookups
+    std::array<Bitboard, 13> pieceBB{};     // one set per Piece, indexed by the enum
+    std::array<Bitboard, 2> colourBB{};     // [white, black]
+    Bitboard occupied = 0;
+
     Board();
 
-    void updateGameState(const Move& move);
+    Bitboard pieces(int colour, int type) const { return pieceBB[makePiece(colour, type)]; }
+
+    void putPiece(int square, int piece);
+    void removePiece(int square);
+    void movePiece(int from, int to);
+    void refreshBitboards();    // rebuild bitboards and hash after squares or state was edited directly
+
+    // Zobrist key of the position, updated incrementally by makeMove/unmakeMove
+    uint64_t hashKey = 0;
+    uint64_t computeHash() const;   // full recompute from scratch
+
+    // key of the pawns alone, indexes the pawn structure cache
+    uint64_t pawnKey = 0;
+    uint64_t computePawnKey() const;
+
+    // material + piece-square sums (white minus black) and game phase for the tapered
+    // evaluation, kept up to date by putPiece/removePiece/movePiece
+    int mgScore = 0;
+    int egScore = 0;
+    int phase = 0;
+    void computeEvalTerms(int& mg, int& eg, int& gamePhase) const;     // full recompute
+
     int findking(bool white) const;
     bool isCheck(bool white) const;
     bool isSquareAttacked(int square, bool byWhite) const;
+    Bitboard attackersTo(int square, Bitboard occupancy) const;    // pieces of both colours
+
+    MoveList generateLegalMoves() const;
+
+    // piece a move takes, must be called before the move is made
+    int capturedPiece(const Move& m) const {
+        if(m.isEnPassant()) return whiteToMove ? B_PAWN : W_PAWN;
+        return m.isCapture() ? squares[m.to()] : EMPTY;
+    }
 
-    std::vector<Move> generateLegalMoves();
+    UndoInfo makeMove(const Move& m);
+    void unmakeMove(const Move& m, const UndoInfo& undo);
 
-    void makeMove(Move&);
+    // pass the turn without moving, for null-move pruning; never legal in check
+    UndoInfo makeNullMove();
+    void unmakeNullMove(const UndoInfo& undo);
     bool whiteToMove = true;
     int enPassantSquare = -1;
     int halfmoveClock = 0;
     int fullMoveNumber = 1;
 
     CastlingRights castlingrights;
-    void UpdateCastlingRights(Move& m);
 
     void setStartPos();
+    FenError fromFEN(std::string_view fen);
     void print(bool white) const;
     std::string toFEN() const;
 
     int parseSquare(const std::string square, bool whitePerspective);
     Move parseMove(const std::string& Move, bool whitePerspective);
-    Move findMatchingMove(const std::vector<Move>& legalMoves, const Move& inputMove);
-    bool IsMoveLegal(const Move& move, const std::vector<Move>& legalMoves);
+    Move findMatchingMove(const MoveList& legalMoves, const Move& inputMove);
+    bool IsMoveLegal(const Move& move, const MoveList& legalMoves);
 
     bool isCheckmate();
     bool isStalemate();
+
+private:
+    void updateGameState(const Move& move);
+    void UpdateCastlingRights(const Move& m);
+
+    // castling rights as bits in CastlingRights field order, matching Zobrist::CASTLING
+    int castlingMask() const {
+        return castlingrights.W_KingSide | castlingrights.W_QueenSide << 1
+             | castlingrights.B_KingSide << 2 | castlingrights.B_QueenSide << 3;
+    }
+    uint64_t enPassantKey() const;
+    void verifyIncrementalState() const;
 };
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "fen_reader.hpp"
+#include <cstring>
+
+static constexpr size_t CHUNK_SIZE = 1 << 20;
+
+FenReader::FenReader(const char* path) : file_(std::fopen(path, "rb")), buffer_(CHUNK_SIZE),
+    begin_(0), end_(0), lineNumber_(0) {}
+
+FenReader::~FenReader(){
+    if(file_) std::fclose(file_);
+}
+
+bool FenReader::nextLine(std::string_view& line){
+    if(!file_) return false;
+
+    while(true){
+        const char* start = buffer_.data() + begin_;
+        const char* newline = static_cast<const char*>(std::memchr(start, '\n', end_ - begin_));
+
+        if(newline){
+            line = std::string_view(start, newline - start);
+            begin_ = newline - buffer_.data() + 1;
+            break;
+        }
+
+        // partial line: move it to the front and append the next chunk
+        std::memmove(buffer_.data(), start, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+        if(end_ == buffer_.size()) buffer_.resize(buffer_.size() * 2);
+
+        size_t read = std::fread(buffer_.data() + end_, 1, buffer_.size() - end_, file_);
+        if(read == 0){
+            // last line without a trailing newline
+            if(end_ == 0) return false;
+            line = std::string_view(buffer_.data(), end_);
+            begin_ = end_;
+            break;
+        }
+        end_ += read;
+    }
+
+    lineNumber_++;
+    if(!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    return true;
+}
+
+bool FenReader::next(Board& board, FenError& error){
+    std::string_view line;
+    do {
+        if(!nextLine(line)) return false;
+    } while(line.find_first_not_of(" \t") == std::string_view::npos);
+
+    error = board.fromFEN(line);
+    return true;
+}
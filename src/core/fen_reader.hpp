@@ -0,0 +1,34 @@
+#pragma once
+#include "board.hpp"
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+// fen_reader.hpp - bulk loader for files holding one FEN per line
+// The file is read in large chunks and lines are parsed straight out of the
+// buffer, so loading a position costs no allocation and no stream overhead.
+class FenReader {
+public:
+    explicit FenReader(const char* path);
+    ~FenReader();
+
+    FenReader(const FenReader&) = delete;
+    FenReader& operator=(const FenReader&) = delete;
+
+    bool isOpen() const { return file_ != nullptr; }
+
+    // loads the next non-empty line into board, false once the file is exhausted.
+    // error tells whether the line parsed; a rejected line leaves board untouched.
+    bool next(Board& board, FenError& error);
+
+    size_t lineNumber() const { return lineNumber_; }
+
+private:
+    bool nextLine(std::string_view& line);
+
+    std::FILE* file_;
+    std::vector<char> buffer_;
+    size_t begin_;          // unread data is buffer_[begin_, end_)
+    size_t end_;
+    size_t lineNumber_;
+};
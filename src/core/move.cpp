@@ -3,13 +3,13 @@
 
 std::string Move::toString() const {
     std::string s;
-    s += fileChar(current_square);
-    s += rankChar(current_square);
-    s += fileChar(target_square);
-    s += rankChar(target_square);
+    s += fileChar(from());
+    s += rankChar(from());
+    s += fileChar(to());
+    s += rankChar(to());
 
-    if(flags & PROMOTION){
-        s += 'q'; //default to queen promotion for now
+    if(isPromotion()){
+        s += "nbrq"[flags() & 3];
     }
 
     return s;
@@ -1,24 +1,94 @@
 #pragma once
+#include <cstdint>
 #include <string>
 
+// 4-bit move flags. Bit 2 marks captures and bit 3 promotions; a promotion
+// keeps the promoted piece in its low two bits (knight, bishop, rook, queen).
 enum MoveFlags {
     QUIET = 0,
-    CAPTURE = 1 << 0,
-    DOUBLE_PAWN_PUSH = 1 << 1,
-    EN_PASSANT = 1 << 3,
-    PROMOTION = 1 << 2,
-    CASTLING = 1 << 4,
-    CAPTURE_N_PROMOTION = 1 << 5
+    DOUBLE_PAWN_PUSH = 1,
+    CASTLING = 2,
+    CAPTURE = 4,
+    EN_PASSANT = 5,
+    PROMOTION = 8,
+    CAPTURE_N_PROMOTION = 12
 };
 
+// promotion flags for a piece type from KNIGHT (1) to QUEEN (4)
+inline int promotionFlags(int pieceType, bool capture) {
+    return (capture ? CAPTURE_N_PROMOTION : PROMOTION) | (pieceType - 1);
+}
+
+// packed move: bits 0-5 from square, bits 6-11 to square, bits 12-15 flags.
+// The captured piece is not stored, read it from the board (Board::capturedPiece)
+// before the move is made or from the UndoInfo afterwards.
 struct Move {
-    int current_square;
-    int target_square;
-    int captured;
-    int promotion;
-    int flags;
+    uint16_t data = 0;
+
+    Move() = default;
+    Move(int from, int to, int flags = QUIET)
+        : data(static_cast<uint16_t>(from | (to << 6) | (flags << 12))) {}
+
+    int from() const { return data & 0x3F; }
+    int to() const { return (data >> 6) & 0x3F; }
+    int flags() const { return data >> 12; }
+
+    // a1a1 can never be played, so the all-zero move doubles as "no move"
+    bool isNull() const { return data == 0; }
+    bool isCapture() const { return flags() & CAPTURE; }
+    bool isPromotion() const { return flags() & PROMOTION; }
+    bool isEnPassant() const { return flags() == EN_PASSANT; }
+    bool isCastling() const { return flags() == CASTLING; }
+    bool isDoublePawnPush() const { return flags() == DOUBLE_PAWN_PUSH; }
+
+    // promoted piece type, KNIGHT (1) to QUEEN (4)
+    int promotionType() const { return (flags() & 3) + 1; }
+
+    bool operator==(const Move& other) const { return data == other.data; }
+    bool operator!=(const Move& other) const { return data != other.data; }
 
     std::string toString() const;
 
 };
 
+// Fixed-capacity move list that lives on the stack, so generating and ordering
+// moves never touches the heap. 256 is above the 218 legal moves possible in
+// any position. scores[i] belongs to moves[i] and is filled by move ordering.
+struct MoveList {
+    static constexpr int CAPACITY = 256;
+
+    Move moves[CAPACITY];
+    int scores[CAPACITY];
+    int count = 0;
+
+    void push_back(const Move& m) { moves[count++] = m; }
+    void clear() { count = 0; }
+    void resize(int n) { count = n; }
+
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Move& operator[](int i) { return moves[i]; }
+    const Move& operator[](int i) const { return moves[i]; }
+
+    Move* begin() { return moves; }
+    Move* end() { return moves + count; }
+    const Move* begin() const { return moves; }
+    const Move* end() const { return moves + count; }
+
+    // stable insertion sort on scores, highest first, keeping each score with its move
+    void sortByScore() {
+        for(int i = 1; i < count; i++){
+            Move m = moves[i];
+            int score = scores[i];
+            int j = i - 1;
+            while(j >= 0 && scores[j] < score){
+                moves[j + 1] = moves[j];
+                scores[j + 1] = scores[j];
+                j--;
+            }
+            moves[j + 1] = m;
+            scores[j + 1] = score;
+        }
+    }
+};
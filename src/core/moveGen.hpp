@@ -1,16 +1,24 @@
 #pragma once
-#include "Board.hpp"
+#include "board.hpp"
 #include "move.hpp"
-#include <vector>
+
+// Legal move generation. Checkers and pinned pieces are found once per position;
+// every piece is then limited to the squares that resolve a check (allowed) and,
+// when pinned, to the line through its king, so no move has to be tried on the board.
+// noisy moves are captures (en passant included) and promotions, quiet moves everything else
+enum GenType { GEN_ALL, GEN_NOISY, GEN_QUIET };
 
 class MoveGen {
 public:
-    static std::vector<Move> GenPseudoLegal(const Board& b, bool whiteToMove);
+    static void GenLegal(const Board& b, MoveList& moves, GenType type = GEN_ALL);
+    static bool isLegal(const Board& b, const Move& move);     // for moves not taken from a generated list
+
+    static Bitboard pinnedPieces(const Board& b, int kingSquare, int us);
 
-    static void addPawnMoves(const Board& b, int square, bool white, std::vector<Move>& moves);
-    static void addKnightMoves(const Board& b, int square, bool white, std::vector<Move>& moves);
-    static void addRookMoves(const Board& b, int square, bool white, std::vector<Move>& moves);
-    static void addBishopMoves(const Board& b, int square, bool white, std::vector<Move>& moves);
-    static void addQueenMoves(const Board& b, int square, bool white, std::vector<Move>& moves);
-    static void addKingMoves(const Board& b, int square, bool white, std::vector<Move>& moves);
-};
\ No newline at end of file
+    static void addPawnMoves(const Board& b, int square, bool white, Bitboard allowed, GenType type, MoveList& moves);
+    static void addKnightMoves(const Board& b, int square, bool white, Bitboard allowed, MoveList& moves);
+    static void addRookMoves(const Board& b, int square, bool white, Bitboard allowed, MoveList& moves);
+    static void addBishopMoves(const Board& b, int square, bool white, Bitboard allowed, MoveList& moves);
+    static void addQueenMoves(const Board& b, int square, bool white, Bitboard allowed, MoveList& moves);
+    static void addKingMoves(const Board& b, int square, bool white, bool inCheck, GenType type, MoveList& moves);
+};
@@ -0,0 +1,17 @@
+#pragma once
+#include "board.hpp"
+#include <cstdint>
+
+// counts the leaf nodes of the legal move tree to the given depth
+uint64_t perft(Board& board, int depth);
+
+// standard perft positions with published node counts, nodes[d - 1] is perft(d)
+struct PerftPosition {
+    const char* name;
+    const char* fen;
+    int depths;
+    uint64_t nodes[6];
+};
+
+extern const PerftPosition PERFT_SUITE[];
+extern const int PERFT_SUITE_SIZE;
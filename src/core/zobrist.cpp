@@ -0,0 +1,42 @@
+#include "zobrist.hpp"
+#include "bitboard.hpp"
+
+namespace Zobrist {
+
+uint64_t PIECE_SQUARE[13][64];
+uint64_t SIDE;
+uint64_t CASTLING[4];
+uint64_t CASTLING_RIGHTS[16];
+uint64_t EN_PASSANT_FILE[8];
+
+using Bitboards::nextRandom;
+
+void init() {
+    uint64_t state = 1070372ULL;
+
+    for(int piece = 0; piece < 13; piece++){
+        for(int sq = 0; sq < 64; sq++){
+            PIECE_SQUARE[piece][sq] = nextRandom(state);
+        }
+    }
+    SIDE = nextRandom(state);
+    for(int i = 0; i < 4; i++){
+        CASTLING[i] = nextRandom(state);
+    }
+    // combined keys, so key(a) ^ key(b) == CASTLING_RIGHTS[a ^ b]
+    for(int mask = 0; mask < 16; mask++){
+        CASTLING_RIGHTS[mask] = 0;
+        for(int i = 0; i < 4; i++){
+            if(mask & (1 << i)) CASTLING_RIGHTS[mask] ^= CASTLING[i];
+        }
+    }
+    for(int f = 0; f < 8; f++){
+        EN_PASSANT_FILE[f] = nextRandom(state);
+    }
+}
+
+// Generated at static initialisation. Other static initialisers must not read the keys,
+// the order across source files is unspecified.
+static const bool keysReady = (init(), true);
+
+} // namespace Zobrist
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+// zobrist.hpp - random keys for incremental position hashing
+// A position's key is the XOR of the keys of everything that is true about it:
+// each piece on its square, black to move, each castling right held and the
+// file of the en passant square when one is set.
+
+namespace Zobrist {
+
+    extern uint64_t PIECE_SQUARE[13][64];   // indexed by Piece, EMPTY row unused
+    extern uint64_t SIDE;                   // xored in when black is to move
+    extern uint64_t CASTLING[4];            // W_KingSide, W_QueenSide, B_KingSide, B_QueenSide
+    extern uint64_t CASTLING_RIGHTS[16];    // XOR of CASTLING[] for every 4-bit set of rights
+    extern uint64_t EN_PASSANT_FILE[8];
+
+    void init();
+}
@@ -2,10 +2,13 @@
 #include "../core/moveGen.hpp"
 #include "../core/utils.hpp"
 #include "../engine/piece_tables.hpp"
+#include "movepicker.hpp"
+#include "see.hpp"
 #include <algorithm>
+#include <cmath>
 #include <random>
-#include <limits>
 #include <iostream>
+#include <thread>
 
 //Piece values in centipawns (100 = 1 pawn)
 const int ChessEngine::PIECE_VALUES[13] = {
@@ -25,7 +28,7 @@ const int ChessEngine::PIECE_VALUES[13] = {
 };
 
 ChessEngine::ChessEngine(EngineLevel level) : level_(level), maxDepth_(3), timeLimit_(5000),
-    nodesSearched_(0), lastEvaluation_(0.0f), lastDepth_(0){
+    nodesSearched_(0), lastEvaluation_(0), lastDepth_(0), ttProbes_(0), ttHits_(0), stopSearch_(false), threads_(1){
 
     switch(level_){
         case EngineLevel::RANDOM:     maxDepth_ = 0; break;
@@ -49,14 +52,35 @@ void ChessEngine::setLevel(EngineLevel level) {
     }
 }
 
-const int ChessEngine::PAWN_TABLE[64] = {0};
-const int ChessEngine::KNIGHT_TABLE[64] = {0};
-const int ChessEngine::BISHOP_TABLE[64] = {0};  
-const int ChessEngine::ROOK_TABLE[64] = {0};
-const int ChessEngine::QUEEN_TABLE[64] = {0};
-const int ChessEngine::KING_MG_TABLE[64] = {0};
-const int ChessEngine::KING_EG_TABLE[64] = {0};
+void ChessEngine::newGame(){
+    transpositionTable_.clear();
+    for(SearchThread& worker : workers_){
+        worker.pawnTable.clear();
+        worker.clearHistory();
+    }
+}
+
+double ChessEngine::getPawnHitRate() const{
+    uint64_t probes = 0, hits = 0;
+    for(const SearchThread& worker : workers_){
+        probes += worker.pawnTable.getProbes();
+        hits += worker.pawnTable.getHits();
+    }
+    return probes ? static_cast<double>(hits) / probes : 0.0;
+}
 
+void SearchThread::clearHistory(){
+    std::fill(&history[0][0][0], &history[0][0][0] + 2 * 64 * 64, 0);
+    std::fill(&counterMoves[0][0], &counterMoves[0][0] + 13 * 64, Move());
+    newSearch();
+}
+
+void SearchThread::newSearch(){
+    std::fill(&killers[0][0], &killers[0][0] + (MAX_PLY + 1) * 2, Move());
+    for(int* h = &history[0][0][0]; h != &history[0][0][0] + 2 * 64 * 64; h++){
+        *h /= 2;
+    }
+}
 
 Move ChessEngine::getBestMove(const Board& board, int timelimit){
     return getBestMove(board, maxDepth_, timelimit);
@@ -66,12 +90,16 @@ Move ChessEngine::getBestMove(const Board& board, int depth, int timeLimit){
     startSearch();
     timeLimit_ = timeLimit;
     nodesSearched_ = 0;
-    lastDepth_ = depth;
+    lastDepth_ = 0;
+    principalVariation_.clear();
+    stopSearch_ = false;
+    transpositionTable_.newSearch();
 
-    std::vector<Move> legalMoves = const_cast<Board&>(board).generateLegalMoves();
+    Board root = board;
+    MoveList legalMoves = root.generateLegalMoves();
 
     if(legalMoves.empty()){
-        return {-1, -1, EMPTY, EMPTY, 0}; //no legal moves(stalemate/checkmate)
+        return {}; //no legal moves(stalemate/checkmate)
     }
 
     if(level_ == EngineLevel::RANDOM){
@@ -81,173 +109,514 @@ Move ChessEngine::getBestMove(const Board& board, int depth, int timeLimit){
         return legalMoves[dis(gen)];
     }
 
-    Move bestMove = legalMoves[0];
-    float bestScore = -std::numeric_limits<float>::infinity();
+    // Lazy SMP: every thread runs its own iterative deepening on its own copy of the
+    // position, and they only cooperate through the shared transposition table
+    workers_.resize(threads_);
+    for(int i = 0; i < threads_; i++){
+        SearchThread& worker = workers_[i];
+        worker.id = i;
+        worker.board = board;
+        worker.nodes = 0;
+        worker.ttProbes = 0;
+        worker.ttHits = 0;
+        worker.completedDepth = 0;
+        worker.bestMove = Move();
+        worker.bestScore = 0;
+        worker.principalVariation.clear();
+        worker.principalVariation.reserve(MAX_PLY);
+        worker.newSearch();
+    }
+
+    std::vector<std::thread> helpers;
+    for(int i = 1; i < threads_; i++){
+        helpers.emplace_back([this, i, depth]{ iterativeDeepening(workers_[i], depth); });
+    }
+
+    iterativeDeepening(workers_[0], depth);
+
+    // the main thread decides when the search is over
+    stopSearch_ = true;
+    for(std::thread& helper : helpers){
+        helper.join();
+    }
+
+    // a helper that completed a deeper iteration has the more reliable answer
+    const SearchThread* best = &workers_[0];
+    ttProbes_ = 0;
+    ttHits_ = 0;
+    for(const SearchThread& worker : workers_){
+        if(worker.completedDepth > best->completedDepth) best = &worker;
+        ttProbes_ += worker.ttProbes;
+        ttHits_ += worker.ttHits;
+    }
+
+    Move bestMove = best->bestMove.isNull() ? legalMoves[0] : best->bestMove;
+    lastDepth_ = best->completedDepth;
+    lastEvaluation_ = best->bestScore;
+    principalVariation_ = best->principalVariation;
+    return bestMove;
+
+}
+
+void ChessEngine::iterativeDeepening(SearchThread& t, int depth){
+    Board& root = t.board;
+    MoveList legalMoves = root.generateLegalMoves();
+
+    // best move from an earlier search of this position goes first
+    TTData ttData;
+    Move ttMove = transpositionTable_.probe(root.hashKey, ttData) ? ttData.move : Move();
+    orderMoves(root, legalMoves, ttMove);
+
+    t.bestMove = legalMoves[0];
+    t.bestScore = 0;
+
+    // iterative deepening: only a fully searched depth may replace the previous answer,
+    // so running out of time mid-iteration still leaves a sound move to play.
+    // Odd helpers run one ply ahead so the threads don't all search the same tree.
+    for(int d = 1 + (t.id & 1); d <= depth; d++){
+        t.rootDepth = d;
+        Score alpha = -SCORE_INFINITE;
+        Score beta = SCORE_INFINITE;
+        Score window = ASPIRATION_WINDOW;
+        if(d >= ASPIRATION_MIN_DEPTH){
+            alpha = t.bestScore - window;
+            beta = t.bestScore + window;
+        }
+
+        Move iterationMove;
+        Score score;
+        while(true){
+            score = searchRoot(t, legalMoves, d, alpha, beta, iterationMove);
+            if(stopSearch_) break;
+
+            // outside the window the score is only a bound, widen that side and search again
+            if(score <= alpha){
+                window *= 2;
+                alpha = window > ASPIRATION_MAX_WINDOW ? -SCORE_INFINITE : t.bestScore - window;
+            }
+            else if(score >= beta){
+                window *= 2;
+                beta = window > ASPIRATION_MAX_WINDOW ? SCORE_INFINITE : t.bestScore + window;
+            }
+            else break;
+        }
+
+        if(stopSearch_) break;
+
+        t.bestMove = iterationMove;
+        t.bestScore = score;
+        t.completedDepth = d;
+        t.principalVariation.assign(t.pv[0], t.pv[0] + t.pvLength[0]);
+        storeTTEntry(root.hashKey, score, d, 0, TT_EXACT, iterationMove);
+
+        // keep the best move at the front so the next iteration searches it first
+        int bestIndex = 0;
+        while(!(legalMoves[bestIndex] == iterationMove)) bestIndex++;
+        for(int i = bestIndex; i > 0; i--){
+            legalMoves[i] = legalMoves[i - 1];
+        }
+        legalMoves[0] = iterationMove;
+
+        // with nothing pruned an exact mate score is a proof, the puzzle is solved
+        if(mateSearch_ && isMateScore(score)){
+            stopSearch_ = true;
+            break;
+        }
+
+        // the next depth costs several times this one, don't start what can't finish
+        if(t.id == 0 && elapsedMs() * 2 >= timeLimit_) break;
+    }
+
+    nodesSearched_.fetch_add(t.nodes, std::memory_order_relaxed);
+    t.nodes = 0;
+}
 
-    std::vector<Move> orderedMoves = orderMoves(board, legalMoves);
+// searches every root move inside (alpha, beta) with PVS, scores are from the root side
+Score ChessEngine::searchRoot(SearchThread& t, const MoveList& moves, int depth, Score alpha, Score beta, Move& bestMove){
+    Board& root = t.board;
+    Score bestScore = -SCORE_INFINITE;
+    bestMove = moves[0];
+    t.pvLength[0] = 0;
 
-    for(Move& move : orderedMoves){
-        if(isTimeUp()) break;
+    for(int i = 0; i < moves.size(); i++){
+        const Move& move = moves[i];
+        t.moveStack[0] = move;
+        UndoInfo undo = root.makeMove(move);
+        Score score = searchMove(t, depth - 1, 1, alpha, beta, i == 0);
+        root.unmakeMove(move, undo);
 
-        Board testBoard = board;
-        testBoard.makeMove(move);
-        testBoard.updateGameState(move);
+        if(stopSearch_) break;
 
-        float score = -alphaBeta(testBoard, depth -1, -std::numeric_limits<float>::infinity(),
-                                std::numeric_limits<float>::infinity(), false);
-        
         if(score > bestScore){
             bestScore = score;
             bestMove = move;
+            if(score > alpha) updatePV(t, 0, move);
         }
+        alpha = std::max(alpha, score);
+        if(alpha >= beta) break;
     }
 
-    lastEvaluation_ = bestScore;
-    return bestMove;
+    return bestScore;
+}
+
+// Principal variation search of one move already made on the board: the first move of
+// a node gets the full window, the rest a null window that only proves they are worse,
+// re-searched with the full window when one turns out better after all. A reduced move
+// that beats alpha is first confirmed at full depth before the full window is opened.
+Score ChessEngine::searchMove(SearchThread& t, int depth, int ply, Score alpha, Score beta,
+                              bool firstMove, int reduction){
+    if(firstMove) return -alphaBeta(t, depth, ply, -beta, -alpha);
+
+    Score score = -alphaBeta(t, depth - reduction, ply, -alpha - 1, -alpha);
+    if(reduction > 0 && score > alpha){
+        score = -alphaBeta(t, depth, ply, -alpha - 1, -alpha);
+    }
+    if(score > alpha && score < beta){
+        score = -alphaBeta(t, depth, ply, -beta, -alpha);
+    }
+    return score;
+}
+
+// the best line from this ply is the move followed by the line its child reported
+void ChessEngine::updatePV(SearchThread& t, int ply, const Move& move){
+    t.pv[ply][0] = move;
+    for(int i = 0; i < t.pvLength[ply + 1]; i++){
+        t.pv[ply][i + 1] = t.pv[ply + 1][i];
+    }
+    t.pvLength[ply] = t.pvLength[ply + 1] + 1;
+}
+
+// LMR_REDUCTIONS[depth][moveNumber] grows with log(depth) * log(moveNumber)
+static int LMR_REDUCTIONS[64][64];
+
+static bool initReductions(){
+    for(int depth = 1; depth < 64; depth++){
+        for(int moves = 1; moves < 64; moves++){
+            LMR_REDUCTIONS[depth][moves] = static_cast<int>(0.75 + std::log(depth) * std::log(moves) / 2.25);
+        }
+    }
+    return true;
+}
 
+static const bool reductionsReady = initReductions();
+
+// Plies a late quiet move is searched short by. Less for PV nodes, moves around a check,
+// killers and counter moves, and moves with good history; more for moves with bad history.
+// The reduced search still reaches at least depth 1.
+int ChessEngine::lateMoveReduction(int depth, int moveNumber, bool pvNode, bool check,
+                                   bool refutation, int history){
+    int reduction = LMR_REDUCTIONS[std::min(depth, 63)][std::min(moveNumber, 63)];
+    reduction -= pvNode + check + refutation;
+    reduction -= history / LMR_HISTORY_DIVISOR;
+    return std::max(0, std::min(reduction, depth - 2));
+}
+
+// game phase weight of a side's knights, bishops, rooks and queens, 0 with only pawns left
+static int nonPawnPhase(const Board& board, int side){
+    int phase = 0;
+    for(int type = KNIGHT; type <= QUEEN; type++){
+        int piece = makePiece(side, type);
+        phase += PieceSquareTables::GAME_PHASE_INC[piece] * Bitboards::popCount(board.pieceBB[piece]);
+    }
+    return phase;
+}
+
+// nodes are counted per thread and published in batches, so the shared counter
+// is written once every NODE_BATCH nodes rather than on every node
+void ChessEngine::countNode(SearchThread& t){
+    if(++t.nodes < NODE_BATCH) return;
+
+    nodesSearched_.fetch_add(t.nodes, std::memory_order_relaxed);
+    t.nodes = 0;
+    if(t.id == 0 && isTimeUp()){
+        stopSearch_ = true;
+    }
 }
 
-float ChessEngine::alphaBeta(Board& board, int depth, float alpha, float beta, bool maximisingPlayer){
-    nodesSearched_++;
+// negamax alpha-beta, scores are from the side to move; ply counts from the root and
+// places mate scores. A node with an open window (beta - alpha > 1) is a PV node.
+Score ChessEngine::alphaBeta(SearchThread& t, int depth, int ply, Score alpha, Score beta){
+    Board& board = t.board;
+    countNode(t);
+    t.pvLength[ply] = 0;
 
-    if(nodesSearched_ % 1000 == 0 && isTimeUp()){
+    if(stopSearch_.load(std::memory_order_relaxed)){
         return 0; 
     }
 
+    if(ply >= MAX_PLY){
+        return quiescenceSearch(t, alpha, beta, 0);
+    }
+
+    // mate distance pruning: no line from here mates faster than the next ply or gets
+    // mated sooner than this one, so a window outside those bounds is already decided
+    alpha = std::max(alpha, matedIn(ply));
+    beta = std::min(beta, mateIn(ply + 1));
+    if(alpha >= beta){
+        return alpha;
+    }
+
+    // check extension: a side in check gets a full ply to answer it, which also keeps
+    // checks at the horizon out of the quiescence search; capped at twice the root depth
+    // so long checking sequences can't run away
+    bool inCheck = board.isCheck(board.whiteToMove);
+    if(inCheck && ply < 2 * t.rootDepth){
+        depth++;
+    }
+
     if(depth == 0){
-        return quiescenceSearch(board, alpha, beta, maximisingPlayer, 0);
+        return quiescenceSearch(t, alpha, beta, 0);
     }
 
-    std::vector<Move> legalMoves = board.generateLegalMoves();
+    bool pvNode = beta - alpha > 1;
+    uint64_t key = hashPosition(board);
+    Score ttScore;
+    Move ttMove;
+    // PV nodes search on so the line below them stays complete
+    if(probeTTEntry(t, key, depth, ply, alpha, beta, ttScore, ttMove) && !pvNode){
+        return ttScore;
+    }
 
-    if(legalMoves.empty()){
-        if(board.isCheck(board.whiteToMove)){
-            return maximisingPlayer ? -20000 + (maxDepth_ - depth) : 20000 - (maxDepth_ - depth);
+    // forward pruning is unsound for proving mates, the mate search does without it
+    bool prune = !pvNode && !inCheck && !mateSearch_;
+    Score staticEval = inCheck ? -SCORE_INFINITE : evaluatePosition(t);
+
+    // reverse futility: so far above beta that the remaining plies won't bring it back
+    if(prune && depth <= pruning_.reverseFutilityDepth && !isMateScore(beta)
+       && staticEval - pruning_.reverseFutilityMargin * depth >= beta){
+        return staticEval;
+    }
+
+    Score nullScore;
+    if(prune && nullMoveCutoff(t, depth, ply, staticEval, beta, nullScore)){
+        return nullScore;
+    }
+
+    // futility: quiet moves can't lift a hopeless static eval to alpha
+    bool futile = prune && depth <= pruning_.futilityDepth && !isMateScore(alpha)
+               && staticEval + pruning_.futilityMargin * depth <= alpha;
+    int lateMoveLimit = prune && depth <= pruning_.lateMoveDepth
+                      ? pruning_.lateMoveBase + depth * depth : 256;
+
+    // the reply that refuted the previous move last time is tried early
+    Move counterMove;
+    if(ply > 0 && !t.moveStack[ply - 1].isNull()){
+        int to = t.moveStack[ply - 1].to();
+        counterMove = t.counterMoves[board.squares[to]][to];
+    }
+
+    // moves come from the picker in stages, most nodes cut off before quiets are generated
+    int side = board.whiteToMove ? WHITE : BLACK;
+    MovePicker picker(board, ttMove, t.killers[ply], counterMove, t.history[side]);
+    int movesSearched = 0;
+
+    Score originalAlpha = alpha;
+    Score bestScore = -SCORE_INFINITE;
+    Move bestMove;
+    Move quietsTried[64];
+    int quietCount = 0;
+
+    for(Move move = picker.next(); !move.isNull(); move = picker.next()){
+        if(!mateSearch_ && pruneLosingCapture(board, move, depth, inCheck, movesSearched, picker.stage())) continue;
+        bool quiet = !move.isCapture() && !move.isPromotion();
+
+        // late move pruning: past the limit the remaining quiets are not searched at all
+        if(quiet && movesSearched > 0 && quietCount >= lateMoveLimit) continue;
+
+        int moveHistory = t.history[side][move.from()][move.to()];
+        t.moveStack[ply] = move;
+        UndoInfo undo = board.makeMove(move);
+        bool givesCheck = board.isCheck(board.whiteToMove);
+
+        if(futile && quiet && movesSearched > 0 && !givesCheck){
+            board.unmakeMove(move, undo);
+            continue;
         }
-        else{
-            return 0;
+        movesSearched++;
+
+        int reduction = 0;
+        if(pruning_.lateMoveReductions && quiet && depth >= LMR_MIN_DEPTH && movesSearched > LMR_MIN_MOVES){
+            bool refutation = move == t.killers[ply][0] || move == t.killers[ply][1] || move == counterMove;
+            reduction = lateMoveReduction(depth, movesSearched, pvNode, inCheck || givesCheck,
+                                          refutation, moveHistory);
+        }
+
+        Score score = searchMove(t, depth - 1, ply + 1, alpha, beta, movesSearched == 1, reduction);
+        board.unmakeMove(move, undo);
+        if(stopSearch_) return 0;
+
+        if(score > bestScore){
+            bestScore = score;
+            bestMove = move;
+            if(score > alpha){
+                alpha = score;
+                updatePV(t, ply, move);
+            }
+        }
+        if(alpha >= beta){
+            if(quiet) updateQuietHistory(t, ply, depth, move, quietsTried, quietCount);
+            break;
         }
+        if(quiet && quietCount < 64) quietsTried[quietCount++] = move;
     }
 
-    std::vector<Move> orderedMoves = orderMoves(board, legalMoves);
+    if(movesSearched == 0){
+        return inCheck ? matedIn(ply) : SCORE_DRAW;
+    }
 
-    if(maximisingPlayer){
-        float maxEval = -std::numeric_limits<float>::infinity();
-        for(Move& move : orderedMoves){
-            Board testBoard = board;
-            testBoard.makeMove(move);
-            testBoard.updateGameState(move);
+    int flag = bestScore <= originalAlpha ? TT_UPPER : bestScore >= beta ? TT_LOWER : TT_EXACT;
+    storeTTEntry(key, bestScore, depth, ply, flag, bestMove);
+    return bestScore;
+}
 
-            float eval = alphaBeta(testBoard, depth -1, alpha, beta, false);
-            maxEval = std::max(maxEval, eval);
-            alpha = std::max(alpha, eval);
+// Null-move pruning: if passing the turn still leaves a reduced search at or above beta,
+// a real move will almost always do at least as well. Not tried twice in a row, nor by a
+// side with only pawns left, where zugzwang makes passing the best option. Deep cutoffs
+// are confirmed by a reduced search of the node itself with null moves switched off.
+bool ChessEngine::nullMoveCutoff(SearchThread& t, int depth, int ply, Score staticEval, Score beta, Score& score){
+    Board& board = t.board;
+    int side = board.whiteToMove ? WHITE : BLACK;
+    if(depth < NULL_MOVE_MIN_DEPTH || !t.nullMoveAllowed || t.moveStack[ply - 1].isNull()
+       || nonPawnPhase(board, side) == 0 || staticEval < beta){
+        return false;
+    }
 
-            if((beta <= alpha)) break;
-        }
-        return maxEval;
+    int reduction = NULL_MOVE_R + depth / NULL_MOVE_R_DIVISOR;
+    t.moveStack[ply] = Move();
+    UndoInfo undo = board.makeNullMove();
+    score = -alphaBeta(t, std::max(depth - 1 - reduction, 0), ply + 1, -beta, -beta + 1);
+    board.unmakeNullMove(undo);
+
+    if(stopSearch_ || score < beta) return false;
+
+    // a mate found after passing proves nothing about the real moves
+    if(isMateScore(score)) score = beta;
+    if(depth < NULL_MOVE_VERIFY_DEPTH) return true;
+
+    t.nullMoveAllowed = false;
+    Score verified = alphaBeta(t, depth - reduction, ply, beta - 1, beta);
+    t.nullMoveAllowed = true;
+    return !stopSearch_ && verified >= beta;
+}
+
+// A quiet move caused a cutoff: it becomes the first killer at this ply and the counter
+// to the previous move, its history rises and the quiets tried before it fall. Updates
+// pull towards +-HISTORY_MAX in proportion to the distance left, so scores never overflow.
+void ChessEngine::updateQuietHistory(SearchThread& t, int ply, int depth, const Move& best,
+                                     const Move* quietsTried, int quietCount){
+    Board& board = t.board;
+    if(t.killers[ply][0] != best){
+        t.killers[ply][1] = t.killers[ply][0];
+        t.killers[ply][0] = best;
+    }
+
+    if(ply > 0 && !t.moveStack[ply - 1].isNull()){
+        int to = t.moveStack[ply - 1].to();
+        t.counterMoves[board.squares[to]][to] = best;
     }
-    else{
-        float minEval = std::numeric_limits<float>::infinity();
-        for(Move& move : orderedMoves){
-            Board testBoard = board;
-            testBoard.makeMove(move);
-            testBoard.updateGameState(move);
 
-            float eval = alphaBeta(testBoard, depth-1, alpha, beta, true);
-            minEval = std::min(minEval, eval);
-            beta = std::min(beta, eval);
+    int (*history)[64] = t.history[board.whiteToMove ? WHITE : BLACK];
+    int bonus = std::min(depth * depth, HISTORY_BONUS_MAX);
+    auto update = [bonus](int& entry, int sign){
+        entry += sign * bonus - entry * bonus / HISTORY_MAX;
+    };
 
-            if(beta <= alpha) break;
-        }
-        return minEval;
+    update(history[best.from()][best.to()], 1);
+    for(int i = 0; i < quietCount; i++){
+        update(history[quietsTried[i].from()][quietsTried[i].to()], -1);
     }
 }
 
-float ChessEngine::evaluatePosition(const Board& board) {
-    float score = PieceSquareTables::evaluateTapered(board);
-    
-    // Add other evaluation components with reduced weights
-    //if (level_ >= EngineLevel::EASY) {
-    //    score += evaluateMobility(board) * 0.05f;
-    //}
-    
+// near the leaves, captures the picker has already ranked as losing are skipped once
+// static exchange says they lose more than SEE_PRUNE_MARGIN per remaining ply
+bool ChessEngine::pruneLosingCapture(const Board& board, const Move& move, int depth, bool inCheck,
+                                     int movesSearched, int stage){
+    return depth <= SEE_PRUNE_DEPTH && !inCheck && movesSearched > 0
+        && stage == STAGE_BAD_CAPTURES && move.isCapture()
+        && !see(board, move, -SEE_PRUNE_MARGIN * depth);
+}
+
+Score ChessEngine::evaluatePosition(SearchThread& t) {
+    const Board& board = t.board;
+    Score score = PieceSquareTables::evaluateTapered(board);
+    if (level_ < EngineLevel::EASY) return score;
+
+    // attack maps are built once and shared by mobility and king safety, pawn attacks
+    // come with the cached pawn structure
+    const PawnEntry& pawns = t.pawnTable.probe(board);
+    EvalInfo info(board, pawns);
+    score += evaluateMobility(board, info);
+
     if (level_ >= EngineLevel::MEDIUM) {
-        score += evaluateKingSafety(board) * 0.1f;
-        score += evaluatePawnStructure(board) * 0.05f;
+        score += evaluateKingSafety(board, info);
+        score += evaluatePawnStructure(board, pawns);
     }
     
     return score;
 }
 
-float ChessEngine::evaluateMaterial(const Board& board){
-    float score = 0;
+Score ChessEngine::evaluateMaterial(const Board& board){
+    Score score = 0;
 
-    for(int sq = 0; sq < 64; ++sq){
-        int piece = board.squares[sq];
-        if(piece == EMPTY) continue;
+    for(int piece = B_PAWN; piece <= W_KING; ++piece){
+        int count = Bitboards::popCount(board.pieceBB[piece]);
 
         if(piece >= W_PAWN){
-            score += PIECE_VALUES[piece];
+            score += PIECE_VALUES[piece] * count;
         }
         else{
-            score -= PIECE_VALUES[piece];
+            score -= PIECE_VALUES[piece] * count;
         }
     }
 
     return score;
 }
 
-float ChessEngine::evaluateMobility(const Board& board){
-    Board tempBoard = board;
-
-    tempBoard.whiteToMove = true;
-    int whiteMoves = tempBoard.generateLegalMoves().size();
+// pseudo-legal reach of the minor and major pieces, tapered and relative to the side to move
+Score ChessEngine::evaluateMobility(const Board& board, const EvalInfo& info){
+    int mg = info.mobilityMg[WHITE] - info.mobilityMg[BLACK];
+    int eg = info.mobilityEg[WHITE] - info.mobilityEg[BLACK];
 
-    tempBoard.whiteToMove = false;
-    int blackMoves = tempBoard.generateLegalMoves().size();
-
-    return (whiteMoves - blackMoves) * 0.3f;
+    int mgPhase = PieceSquareTables::calculateGamePhase(board);
+    Score score = (mg * mgPhase + eg * (24 - mgPhase)) / 24;
+    return board.whiteToMove ? score : -score;
 }
 
-std::vector<Move> ChessEngine::orderMoves(const Board& board, const std::vector<Move>& moves){
-    std::vector<std::pair<Move, int>> scoredMoves;
-
-    for(const Move& move : moves) {
-        int score = getMoveOrderScore(board, move);
-        scoredMoves.push_back({move, score});
+void ChessEngine::orderMoves(const Board& board, MoveList& moves, const Move& ttMove){
+    for(int i = 0; i < moves.size(); i++) {
+        moves.scores[i] = getMoveOrderScore(board, moves[i], ttMove);
     }
 
     //sort by highest score
-    std::sort(scoredMoves.begin(), scoredMoves.end(),[](const auto&a, const auto& b) {return a.second > b.second; });
+    moves.sortByScore();
+}
 
-    std::vector<Move> orderedMoves;
-    for(const auto& pair : scoredMoves){
-        orderedMoves.push_back(pair.first);
+int ChessEngine::getMoveOrderScore(const Board& board, const Move& move, const Move& ttMove){
+    // the stored best move was good enough last time, try it before anything else
+    if(!ttMove.isNull() && move == ttMove){
+        return 1000000;
     }
 
-    return orderedMoves;
-}
-
-int ChessEngine::getMoveOrderScore(const Board& board, const Move& move){
     int score = 0;
 
-    if(move.flags & CAPTURE){
+    if(move.isCapture()){
         score += 1000;
         //difference in value of pieces in capture move (capturee - capturer)
-        score += PieceSquareTables::MG_PIECE_VALUES[move.captured] - 
-                 PieceSquareTables::MG_PIECE_VALUES[board.squares[move.current_square]] / 10;
+        score += PieceSquareTables::MG_PIECE_VALUES[board.capturedPiece(move)] - 
+                 PieceSquareTables::MG_PIECE_VALUES[board.squares[move.from()]] / 10;
     }
 
-    if(move.flags & PROMOTION){
+    // underpromotions are rarely right, leave them with the quiet moves
+    if(move.isPromotion() && move.promotionType() == QUEEN){
         score += 900;
     }
 
-    if(move.flags & CASTLING){
+    if(move.isCastling()){
         score += 100;
     }
 
-    int toFile = file(move.target_square);
-    int toRank = rank(move.target_square);
+    int toFile = file(move.to());
+    int toRank = rank(move.to());
     if(toFile >= 2 && toFile <= 5 && toRank >= 2 && toRank <= 5){
         score += 10;
     }
@@ -259,54 +628,92 @@ void ChessEngine::startSearch(){
     searchStartTime_ = std::chrono::steady_clock::now();
 }
 
-bool ChessEngine::isTimeUp() const{
+long long ChessEngine::elapsedMs() const{
     auto elapsed = std::chrono::steady_clock::now() - searchStartTime_;
-    return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() >= timeLimit_;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
 }
 
-float ChessEngine::evaluatePieceSquares(const Board& board){
-    //TO DO
-
-    return 0.0f;
+bool ChessEngine::isTimeUp() const{
+    return elapsedMs() >= timeLimit_;
 }
 
-float ChessEngine::evaluateKingSafety(const Board& board){
-    //TO DO
-    return 0.0f;
-}
+// attacks on the king zone, safe checks, pawn shelter and storm, open files by the king; middlegame
+// only, tapered and relative to the side to move
+Score ChessEngine::evaluateKingSafety(const Board& board, const EvalInfo& info){
+    int mg = PawnStructure::shield(board) + PawnStructure::storm(board);
+    mg += kingDanger(board, info, BLACK) - kingDanger(board, info, WHITE);
 
-float ChessEngine::evaluatePawnStructure(const Board& board){
-    //To Do
-    return 0.0f;
+    Score score = mg * PieceSquareTables::calculateGamePhase(board) / 24;
+    return board.whiteToMove ? score : -score;
 }
 
-float ChessEngine::minimax(Board& board, int depth, bool maximizingPlayer) {
-    // TODO: Implement minimax (can use alphaBeta for now)
-    return alphaBeta(board, depth, -std::numeric_limits<float>::infinity(), 
-                     std::numeric_limits<float>::infinity(), maximizingPlayer);
+// penalty for the king of the given colour
+int ChessEngine::kingDanger(const Board& board, const EvalInfo& info, int colour){
+    int them = colour ^ 1;
+    int danger = 0;
+
+    // a lone attacker is rarely dangerous, two or more and the threat grows quickly
+    if(info.kingAttackers[them] >= 2){
+        int units = info.kingAttackUnits[them];
+        danger += std::min(units * units / 4, KING_DANGER_MAX);
+    }
+
+    Bitboard king = board.pieces(colour, KING);
+    if(!king) return danger;
+
+    // squares an enemy piece could give check from that no defender covers and no enemy
+    // piece stands on
+    int kingSq = Bitboards::lsb(king);
+    Bitboard safe = ~(info.attacked[colour] | board.colourBB[them]);
+    Bitboard diagonal = Bitboards::bishopAttacks(kingSq, board.occupied);
+    Bitboard straight = Bitboards::rookAttacks(kingSq, board.occupied);
+    if(Bitboards::KNIGHT_ATTACKS[kingSq] & info.attackedBy[them][KNIGHT] & safe) danger += SAFE_CHECK[KNIGHT];
+    if(diagonal & info.attackedBy[them][BISHOP] & safe) danger += SAFE_CHECK[BISHOP];
+    if(straight & info.attackedBy[them][ROOK] & safe) danger += SAFE_CHECK[ROOK];
+    if((diagonal | straight) & info.attackedBy[them][QUEEN] & safe) danger += SAFE_CHECK[QUEEN];
+
+    if(board.pieces(them, ROOK) | board.pieces(them, QUEEN)){
+        int kingFile = file(kingSq);
+        for(int f = std::max(kingFile - 1, 0); f <= std::min(kingFile + 1, 7); f++){
+            Bitboard fileBB = Bitboards::FILE_A << f;
+            if(board.pieces(colour, PAWN) & fileBB) continue;
+            danger += (board.pieces(them, PAWN) & fileBB) ? KING_SEMI_OPEN_FILE : KING_OPEN_FILE;
+        }
+    }
+    return danger;
 }
 
-float ChessEngine::quiescenceSearch(Board& board, float alpha, float beta, bool maximizingPlayer, int qDepth) {
+// cached pawn terms plus blockaded passers, tapered and relative to the side to move
+Score ChessEngine::evaluatePawnStructure(const Board& board, const PawnEntry& pawns){
+    int mg, eg;
+    PawnStructure::blockedPassers(board, pawns, mg, eg);
+    mg += pawns.mgScore;
+    eg += pawns.egScore;
 
-    //URGENT - FIX Quiesence search 
-    
-    nodesSearched_++;
+    int mgPhase = PieceSquareTables::calculateGamePhase(board);
+    Score score = (mg * mgPhase + eg * (24 - mgPhase)) / 24;
+    return board.whiteToMove ? score : -score;
+}
+
+// negamax over captures, alpha/beta and the returned score are from the side to move
+Score ChessEngine::quiescenceSearch(SearchThread& t, Score alpha, Score beta, int qDepth) {
+    Board& board = t.board;
+    countNode(t);
 
     // LIMIT 1: Max quiescence depth (prevent infinite recursion)
     const int MAX_Q_DEPTH = 6;  // Don't search captures more than 6 moves deep
     if (qDepth >= MAX_Q_DEPTH) {
-        return evaluatePosition(board) * (maximizingPlayer ? 1 : -1);
+        return evaluatePosition(t);
     }
 
     //Stand PAT eval - static eval without involving captures
-    float standPat = evaluatePosition(board);
-    if(!maximizingPlayer) standPat = -standPat;
+    Score standPat = evaluatePosition(t);
 
     //Beta cutoff - if this position is already good, opposition will try to prevent the current line
     if(standPat >= beta) return beta;
 
     // LIMIT 2: Delta pruning - don't search hopeless captures
-    const float BIG_DELTA = 900;  // Queen value
+    const Score BIG_DELTA = 900;  // Queen value
     if (standPat < alpha - BIG_DELTA) {
         return standPat;  // Even winning a queen won't help
     }
@@ -314,23 +721,25 @@ float ChessEngine::quiescenceSearch(Board& board, float alpha, float beta, bool
     
     if(standPat > alpha) alpha = standPat;
 
-    std::vector<Move> noisyMoves = generateNoisyMoves(board);
+    MoveList goodCaptures = generateNoisyMoves(board);
 
-    if(noisyMoves.empty()) return standPat;
+    if(goodCaptures.empty()) return standPat;
 
-    // LIMIT 3: Only search good captures (reduce branching)
-    std::vector<Move> goodCaptures;
-    for (const Move& move : noisyMoves) {
-        if (move.flags & CAPTURE) {
-            // Only search if capturing piece is less valuable than captured piece
-            if (PieceSquareTables::MG_PIECE_VALUES[move.captured] >= 
-                PieceSquareTables::MG_PIECE_VALUES[board.squares[move.current_square]]) {
-                goodCaptures.push_back(move);
+    // LIMIT 3: Only search good captures (reduce branching), filtered in place
+    int goodCount = 0;
+    for (int i = 0; i < goodCaptures.size(); i++) {
+        const Move move = goodCaptures[i];
+        if (move.isPromotion() && move.promotionType() != QUEEN) continue;  // underpromotions stay out
+        if (move.isCapture()) {
+            // Only search captures that don't lose material once the exchange is played out
+            if (see(board, move, 0)) {
+                goodCaptures[goodCount++] = move;
             }
-        } else if (move.flags & PROMOTION) {
-            goodCaptures.push_back(move);  // Always search promotions
+        } else if (move.isPromotion()) {
+            goodCaptures[goodCount++] = move;  // Always search promotions
         }
     }
+    goodCaptures.resize(goodCount);
 
     // LIMIT 4: Max captures per position (prevent explosion)
     if (goodCaptures.size() > 8) {
@@ -341,18 +750,13 @@ float ChessEngine::quiescenceSearch(Board& board, float alpha, float beta, bool
         orderNoisyMoves(board, goodCaptures);
     }
 
-
-    // best captures first (MVV - LVA)
-    orderNoisyMoves(board, noisyMoves);
-
-    //Search noisy moves
-    for(Move& move : goodCaptures){
-        Board testBoard = board;
-        testBoard.makeMove(move);
-        testBoard.updateGameState(move);
+    //Search noisy moves, best captures first (MVV - LVA)
+    for(const Move& move : goodCaptures){
+        UndoInfo undo = board.makeMove(move);
 
         //recursively search this noisy position
-        float score = -quiescenceSearch(testBoard, -beta, -alpha, !maximizingPlayer, qDepth+1);
+        Score score = -quiescenceSearch(t, -beta, -alpha, qDepth+1);
+        board.unmakeMove(move, undo);
 
         if(score >= beta) return beta;
         if(score > alpha) alpha = score;
@@ -363,48 +767,48 @@ float ChessEngine::quiescenceSearch(Board& board, float alpha, float beta, bool
 
 }
 
-std::vector<Move> ChessEngine::generateNoisyMoves(const Board& board){
-    std::vector<Move> allMoves = const_cast<Board&>(board).generateLegalMoves();
-    std::vector<Move> noisyMoves;
-
-    for(const Move& move : allMoves){
-        if(move.flags & CAPTURE || move.flags & PROMOTION ){  //optional - check for moves that cause checks
-            noisyMoves.push_back(move);
-        }
-    }
-    return noisyMoves;
+MoveList ChessEngine::generateNoisyMoves(Board& board){
+    MoveList moves;
+    MoveGen::GenLegal(board, moves, GEN_NOISY);    //optional - check for moves that cause checks
+    return moves;
 }
 
-void ChessEngine::orderNoisyMoves(const Board& board, std::vector<Move>& moves){
-    std::sort(moves.begin(), moves.end(), [&](const Move& a, const Move& b){
-        //MVV-LVA
-        int scoreA = 0, scoreB = 0;
-        
-        if(a.flags & CAPTURE){
-            scoreA = PieceSquareTables::MG_PIECE_VALUES[a.captured] - 
-                     PieceSquareTables::MG_PIECE_VALUES[board.squares[a.current_square]] / 10;
-        }
+void ChessEngine::orderNoisyMoves(const Board& board, MoveList& moves){
+    //MVV-LVA
+    for(int i = 0; i < moves.size(); i++){
+        const Move& move = moves[i];
+        moves.scores[i] = 0;
 
-        if(b.flags & CAPTURE) {
-            scoreB =PieceSquareTables::MG_PIECE_VALUES[b.captured] - 
-                     PieceSquareTables::MG_PIECE_VALUES[board.squares[b.current_square]] / 10;
+        if(move.isCapture()){
+            moves.scores[i] = PieceSquareTables::MG_PIECE_VALUES[board.capturedPiece(move)] - 
+                              PieceSquareTables::MG_PIECE_VALUES[board.squares[move.from()]] / 10;
         }
+    }
 
-        return scoreA > scoreB;
-    
-    });
+    moves.sortByScore();
 }
 
 uint64_t ChessEngine::hashPosition(const Board& board) {
-    // TODO: Implement position hashing
-    return 0;
+    return board.hashKey;
 }
 
-void ChessEngine::storeTTEntry(uint64_t key, float score, int depth, int flag, const Move& bestMove) {
-    // TODO: Implement transposition table storage
+void ChessEngine::storeTTEntry(uint64_t key, Score score, int depth, int ply, int flag, const Move& bestMove) {
+    transpositionTable_.store(key, scoreToTT(score, ply), depth, flag, bestMove);
 }
 
-bool ChessEngine::probeTTEntry(uint64_t key, int depth, float alpha, float beta, float& score, Move& bestMove) {
-    // TODO: Implement transposition table lookup
-    return false;
-}
\ No newline at end of file
+// returns true when the stored result settles this node; bestMove is filled on any hit
+bool ChessEngine::probeTTEntry(SearchThread& t, uint64_t key, int depth, int ply, Score alpha, Score beta,
+                               Score& score, Move& bestMove) {
+    TTData data;
+    t.ttProbes++;
+    if(!transpositionTable_.probe(key, data)) return false;
+    t.ttHits++;
+
+    bestMove = data.move;
+    if(data.depth < depth) return false;
+
+    score = scoreFromTT(data.score, ply);
+    return data.flag == TT_EXACT
+        || (data.flag == TT_LOWER && score >= beta)
+        || (data.flag == TT_UPPER && score <= alpha);
+}
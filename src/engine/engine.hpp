@@ -1,9 +1,12 @@
 #pragma once
 #include "../core/board.hpp"
 #include "../core/move.hpp"
+#include "transposition.hpp"
+#include "pawns.hpp"
+#include "eval_info.hpp"
+#include <atomic>
 #include <vector>
 #include <chrono>
-#include <unordered_map>
 
 enum class EngineLevel {
     RANDOM = 0,
@@ -14,13 +17,46 @@ enum class EngineLevel {
     EXPERT            //Depth 5+  - Fully optimised
 };
 
-// transposition table entry
-struct TTEntry {
-    uint64_t key;       //Position hashkey
-    float score;        //Evaluation score
-    int depth;          //Search depth
-    int flag;           //Exact, lower bound, or upper bound
-    Move bestMove;      //Best move from this position
+// Search state owned by a single thread. The transposition table, node total and
+// stop flag live in ChessEngine and are shared by all threads.
+struct SearchThread {
+    int id = 0;                 // 0 is the main thread, which owns the clock
+    Board board;                // position being searched, made/unmade in place
+    uint64_t nodes = 0;         // nodes not yet added to the shared total
+    uint64_t ttProbes = 0;      // table statistics, kept per thread so probes don't share
+    uint64_t ttHits = 0;        // a cache line; summed once the search is over
+    int completedDepth = 0;
+    int rootDepth = 0;          // depth of the iteration in progress, bounds check extensions
+    Move bestMove;              // result of the last completed iteration
+    Score bestScore = 0;
+    std::vector<Move> principalVariation;   // of the last completed iteration
+    PawnTable pawnTable;        // kept between searches, pawn structures carry over
+
+    // triangular PV table: pv[ply] holds the best line found from ply onwards
+    Move pv[MAX_PLY + 1][MAX_PLY + 1];
+    int pvLength[MAX_PLY + 1] = {};
+
+    // quiet move ordering, learnt from cutoffs and kept across iterations
+    Move moveStack[MAX_PLY + 1];        // move played at each ply of the current line
+    Move killers[MAX_PLY + 1][2];       // quiet cutoff moves per ply, newest first
+    int history[2][64][64] = {};        // [side][from][to] butterfly history
+    Move counterMoves[13][64];          // reply that refuted [piece][to] of the previous move
+    bool nullMoveAllowed = true;        // off while a null-move cutoff is being verified
+
+    void clearHistory();
+    void newSearch();                   // forget killers, age history, keep counter moves
+};
+
+// Shallow-depth forward pruning and late move reductions, kept apart from the engine so
+// they can be tuned or switched off. Margins are in centipawns per ply of remaining depth.
+struct PruningParams {
+    int reverseFutilityDepth = 6;       // static eval - margin * depth >= beta cuts the node
+    int reverseFutilityMargin = 80;
+    int futilityDepth = 4;              // static eval + margin * depth <= alpha skips quiets
+    int futilityMargin = 100;
+    int lateMoveDepth = 4;              // only lateMoveBase + depth^2 quiets are searched
+    int lateMoveBase = 3;
+    bool lateMoveReductions = true;     // LMR, see ChessEngine::lateMoveReduction
 };
 
 class ChessEngine {
@@ -35,66 +71,125 @@ public:
     void setLevel(EngineLevel level);
     void setTimeLimit(int milliseconds) { timeLimit_ = milliseconds; }
     void setMaxDepth(int depth) { maxDepth_ = depth; }
+    void setHashSize(size_t megabytes) { transpositionTable_.resize(megabytes); }
+    void newGame();
+    void setThreads(int threads) { threads_ = threads < 1 ? 1 : threads; }
+    int getThreads() const { return threads_; }
+    void setPruningParams(const PruningParams& params) { pruning_ = params; }
+    const PruningParams& getPruningParams() const { return pruning_; }
+    // Mate search: forward pruning is switched off so a mate score is a proof, and the
+    // search stops at the first completed iteration that proves a forced mate.
+    void setMateSearch(bool enabled) { mateSearch_ = enabled; }
+    bool getMateSearch() const { return mateSearch_; }
 
     //Statistics
-    int getNodesSearched() const { return nodesSearched_; }
-    float getLastEvaluation() const { return lastEvaluation_; }
+    uint64_t getNodesSearched() const { return nodesSearched_; }
+    Score getLastEvaluation() const { return lastEvaluation_; }     // side to move at the root
+    const std::vector<Move>& getPrincipalVariation() const { return principalVariation_; }
     int getLastDepth() const { return lastDepth_; }
+    double getTTHitRate() const { return ttProbes_ ? static_cast<double>(ttHits_) / ttProbes_ : 0.0; }
+    int getHashfull() const { return transpositionTable_.hashfull(); }
+    double getPawnHitRate() const;
+    const std::vector<SearchThread>& getSearchThreads() const { return workers_; }   // state of the last search
 
 private:
     //SEARCH ALGORITHMS
-    float minimax(Board& board, int depth, bool maximizingPlayer);
-    float alphaBeta(Board& board, int depth, float alpha, float beta, bool maximizingPlayer);
-    float quiescenceSearch(Board& board, float alpha, float beta, bool maximizingPlayer, int qDepth);
+    void iterativeDeepening(SearchThread& t, int depth);
+    Score alphaBeta(SearchThread& t, int depth, int ply, Score alpha, Score beta);
+    Score searchRoot(SearchThread& t, const MoveList& moves, int depth, Score alpha, Score beta, Move& bestMove);
+    Score searchMove(SearchThread& t, int depth, int ply, Score alpha, Score beta,
+                     bool firstMove, int reduction = 0);
+    int lateMoveReduction(int depth, int moveNumber, bool pvNode, bool check, bool refutation, int history);
+    void updatePV(SearchThread& t, int ply, const Move& move);
+    bool nullMoveCutoff(SearchThread& t, int depth, int ply, Score staticEval, Score beta, Score& score);
+    void updateQuietHistory(SearchThread& t, int ply, int depth, const Move& best,
+                            const Move* quietsTried, int quietCount);
+    Score quiescenceSearch(SearchThread& t, Score alpha, Score beta, int qDepth);
+    bool pruneLosingCapture(const Board& board, const Move& move, int depth, bool inCheck,
+                            int movesSearched, int stage);
     
     //EVALUATION FUNCTIONS
-    float evaluatePosition(const Board& board);
-    float evaluateMaterial(const Board& board);
-    float evaluatePieceSquares(const Board& board);
-    float evaluateKingSafety(const Board& board);
-    float evaluatePawnStructure(const Board& board);
-    float evaluateMobility(const Board& board);
+    Score evaluatePosition(SearchThread& t);
+    Score evaluateMaterial(const Board& board);
+    Score evaluateKingSafety(const Board& board, const EvalInfo& info);
+    int kingDanger(const Board& board, const EvalInfo& info, int colour);
+    Score evaluatePawnStructure(const Board& board, const PawnEntry& pawns);
+    Score evaluateMobility(const Board& board, const EvalInfo& info);
     
     //MOVE ORDERING
-    std::vector<Move> orderMoves(const Board& board, const std::vector<Move>& moves);
-    int getMoveOrderScore(const Board& board, const Move& move);
+    void orderMoves(const Board& board, MoveList& moves, const Move& ttMove = Move());
+    int getMoveOrderScore(const Board& board, const Move& move, const Move& ttMove);
     
     //UTILITY FUNCTIONS
     bool isTimeUp() const;
+    void countNode(SearchThread& t);
+    long long elapsedMs() const;
     void startSearch();
     uint64_t hashPosition(const Board& board);
     //for quiesence search
-    std::vector<Move> generateNoisyMoves(const Board& board);
-    void orderNoisyMoves(const Board& board, std::vector<Move>& moves);
+    MoveList generateNoisyMoves(Board& board);
+    void orderNoisyMoves(const Board& board, MoveList& moves);
     
     //TRANSPOSITION TABLE
-    void storeTTEntry(uint64_t key, float score, int depth, int flag, const Move& bestMove);
-    bool probeTTEntry(uint64_t key, int depth, float alpha, float beta, float& score, Move& bestMove);
+    void storeTTEntry(uint64_t key, Score score, int depth, int ply, int flag, const Move& bestMove);
+    bool probeTTEntry(SearchThread& t, uint64_t key, int depth, int ply, Score alpha, Score beta, Score& score, Move& bestMove);
     
     //Engine settings
     EngineLevel level_;
     int maxDepth_;
     int timeLimit_;
     
-    //Search state
-    int nodesSearched_;
-    float lastEvaluation_;
+    //Search state, shared by all search threads
+    std::atomic<uint64_t> nodesSearched_;
+    Score lastEvaluation_;
+    std::vector<Move> principalVariation_;
     int lastDepth_;
+    uint64_t ttProbes_;                 //of the last search, summed over all threads
+    uint64_t ttHits_;
+    std::atomic<bool> stopSearch_;      //set once the time limit fires, results after that are incomplete
     std::chrono::steady_clock::time_point searchStartTime_;
+    int threads_;
+    PruningParams pruning_;
+    bool mateSearch_ = false;
+    std::vector<SearchThread> workers_;     //one per thread, resized when the thread count changes
+    static constexpr uint64_t NODE_BATCH = 1024;
     
     //Transposition table
-    std::unordered_map<uint64_t, TTEntry> transpositionTable_;
+    TranspositionTable transpositionTable_;
     
+    //Aspiration windows, in centipawns around the previous iteration's score
+    static constexpr Score ASPIRATION_WINDOW = 50;
+    static constexpr Score ASPIRATION_MAX_WINDOW = 800;
+    static constexpr int ASPIRATION_MIN_DEPTH = 4;
+
+    //Losing captures are pruned up to this depth, margin in centipawns per ply
+    static constexpr int SEE_PRUNE_DEPTH = 3;
+    static constexpr int SEE_PRUNE_MARGIN = 100;
+
+    //King safety, middlegame centipawns: attack units are squared and capped, open files
+    //next to the king only count while the enemy has a rook or queen
+    static constexpr int KING_DANGER_MAX = 500;
+    static constexpr int KING_OPEN_FILE = 20;
+    static constexpr int KING_SEMI_OPEN_FILE = 10;
+
+    //Null-move pruning from NULL_MOVE_MIN_DEPTH, reducing by NULL_MOVE_R + depth / NULL_MOVE_R_DIVISOR;
+    //cutoffs from NULL_MOVE_VERIFY_DEPTH on are verified without null moves
+    static constexpr int NULL_MOVE_MIN_DEPTH = 3;
+    static constexpr int NULL_MOVE_R = 2;
+    static constexpr int NULL_MOVE_R_DIVISOR = 4;
+    static constexpr int NULL_MOVE_VERIFY_DEPTH = 10;
+
+    //Late move reductions for quiet moves from LMR_MIN_DEPTH, after LMR_MIN_MOVES moves;
+    //every LMR_HISTORY_DIVISOR of history takes a ply off the reduction or adds one
+    static constexpr int LMR_MIN_DEPTH = 3;
+    static constexpr int LMR_MIN_MOVES = 2;
+    static constexpr int LMR_HISTORY_DIVISOR = 6000;
+
+    //History scores stay within +-HISTORY_MAX, a cutoff adds depth^2 up to HISTORY_BONUS_MAX
+    static constexpr int HISTORY_MAX = 16384;
+    static constexpr int HISTORY_BONUS_MAX = 1200;
+
     //Piece values for evaluation
     static const int PIECE_VALUES[13];
-    
-    //Piece-square tables for positional evaluation
-    static const int PAWN_TABLE[64];
-    static const int KNIGHT_TABLE[64];
-    static const int BISHOP_TABLE[64];
-    static const int ROOK_TABLE[64];
-    static const int QUEEN_TABLE[64];
-    static const int KING_MG_TABLE[64];  // King middlegame
-    static const int KING_EG_TABLE[64];  // King endgame
 };
 
@@ -0,0 +1,79 @@
+#include "eval_info.hpp"
+
+using namespace Bitboards;
+
+const int KING_ATTACK_WEIGHT[6] = {0, 2, 2, 3, 5, 0};
+const int SAFE_CHECK[6] = {0, 30, 15, 25, 20, 0};
+
+const int MOBILITY_BASE[6] = {0, 4, 6, 7, 13, 0};
+const int MOBILITY_MG[6] = {0, 4, 5, 2, 1, 0};
+const int MOBILITY_EG[6] = {0, 4, 5, 4, 2, 0};
+
+template<int Type>
+static Bitboard pieceAttacks(int sq, Bitboard occupied){
+    if(Type == KNIGHT) return KNIGHT_ATTACKS[sq];
+    if(Type == BISHOP) return bishopAttacks(sq, occupied);
+    if(Type == ROOK) return rookAttacks(sq, occupied);
+    return queenAttacks(sq, occupied);
+}
+
+// fills the attack map of one piece type, scores its mobility and its hits on the
+// enemy king zone
+template<int Type>
+static void addAttacks(const Board& board, int colour, EvalInfo& info){
+    Bitboard enemyZone = info.kingZone[colour ^ 1];
+    Bitboard pieces = board.pieces(colour, Type);
+    while(pieces){
+        Bitboard attacks = pieceAttacks<Type>(popLsb(pieces), board.occupied);
+        info.attackedBy[colour][Type] |= attacks;
+
+        int reach = popCount(attacks & info.mobilityArea[colour]) - MOBILITY_BASE[Type];
+        info.mobilityMg[colour] += MOBILITY_MG[Type] * reach;
+        info.mobilityEg[colour] += MOBILITY_EG[Type] * reach;
+
+        Bitboard zoneHits = attacks & enemyZone;
+        if(zoneHits){
+            info.kingAttackers[colour]++;
+            info.kingAttackUnits[colour] += KING_ATTACK_WEIGHT[Type] * popCount(zoneHits);
+        }
+    }
+}
+
+// everything but the pawn attacks, which the caller fills in first
+static void buildAttacks(const Board& board, EvalInfo& info){
+    for(int colour = WHITE; colour <= BLACK; colour++){
+        Bitboard king = board.pieces(colour, KING);
+        if(!king) continue;
+
+        int sq = lsb(king);
+        Bitboard zone = KING_ATTACKS[sq] | squareBB(sq);
+        info.kingZone[colour] = zone | (colour == WHITE ? zone << 8 : zone >> 8);
+        info.attackedBy[colour][KING] = KING_ATTACKS[sq];
+    }
+
+    info.mobilityArea[WHITE] = ~(board.colourBB[WHITE] | info.attackedBy[BLACK][PAWN]);
+    info.mobilityArea[BLACK] = ~(board.colourBB[BLACK] | info.attackedBy[WHITE][PAWN]);
+
+    for(int colour = WHITE; colour <= BLACK; colour++){
+        addAttacks<KNIGHT>(board, colour, info);
+        addAttacks<BISHOP>(board, colour, info);
+        addAttacks<ROOK>(board, colour, info);
+        addAttacks<QUEEN>(board, colour, info);
+
+        for(int type = PAWN; type <= KING; type++){
+            info.attacked[colour] |= info.attackedBy[colour][type];
+        }
+    }
+}
+
+EvalInfo::EvalInfo(const Board& board){
+    attackedBy[WHITE][PAWN] = pawnAttacks(board.pieces(WHITE, PAWN), WHITE);
+    attackedBy[BLACK][PAWN] = pawnAttacks(board.pieces(BLACK, PAWN), BLACK);
+    buildAttacks(board, *this);
+}
+
+EvalInfo::EvalInfo(const Board& board, const PawnEntry& pawns){
+    attackedBy[WHITE][PAWN] = pawns.attacks[WHITE];
+    attackedBy[BLACK][PAWN] = pawns.attacks[BLACK];
+    buildAttacks(board, *this);
+}
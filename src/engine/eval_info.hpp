@@ -0,0 +1,34 @@
+#pragma once
+#include "../core/board.hpp"
+#include "pawns.hpp"
+
+// eval_info.hpp - attack maps shared by the evaluation terms
+// Every piece's attack set is generated once per evaluation, and the king safety and
+// mobility terms both read from the same maps instead of probing squares one by one.
+
+// weight of one attacked king zone square, indexed by PieceType of the attacker
+extern const int KING_ATTACK_WEIGHT[6];
+
+// king danger for each enemy piece type that has a safe square to check the king from,
+// indexed by PieceType of the checker
+extern const int SAFE_CHECK[6];
+
+// Mobility per reachable square, indexed by PieceType. A piece is scored relative to
+// MOBILITY_BASE squares, so an extra piece with average scope adds nothing by itself.
+extern const int MOBILITY_BASE[6];
+extern const int MOBILITY_MG[6];
+extern const int MOBILITY_EG[6];
+
+struct EvalInfo {
+    Bitboard attackedBy[2][6] = {};     // [colour][PieceType] squares attacked
+    Bitboard attacked[2] = {};          // attacked by any piece of that colour
+    Bitboard kingZone[2] = {};          // king, its neighbours and one more rank forward
+    int kingAttackers[2] = {};          // pieces of that colour hitting the enemy king zone
+    int kingAttackUnits[2] = {};        // weighted count of enemy king zone squares hit
+    Bitboard mobilityArea[2] = {};      // squares free of own pieces and enemy pawn attacks
+    int mobilityMg[2] = {};
+    int mobilityEg[2] = {};
+
+    explicit EvalInfo(const Board& board);
+    EvalInfo(const Board& board, const PawnEntry& pawns);   // pawn attacks taken from the pawn table
+};
@@ -0,0 +1,144 @@
+#include "movepicker.hpp"
+#include "piece_tables.hpp"
+#include "see.hpp"
+#include "../core/moveGen.hpp"
+#include "../core/utils.hpp"
+
+MovePicker::MovePicker(const Board& board, const Move& ttMove, const Move* killers,
+                       const Move& counterMove, const int (*history)[64])
+    : board_(board), ttMove_(ttMove), counterMove_(counterMove), history_(history),
+      stage_(STAGE_TT_MOVE), captureIndex_(0), badCaptureIndex_(0), quietIndex_(0) {
+    killers_[0] = killers ? killers[0] : Move();
+    killers_[1] = killers ? killers[1] : Move();
+}
+
+Move MovePicker::next(){
+    switch(stage_){
+        case STAGE_TT_MOVE:
+            stage_ = STAGE_GEN_CAPTURES;
+            if(MoveGen::isLegal(board_, ttMove_)) return ttMove_;
+            [[fallthrough]];
+
+        case STAGE_GEN_CAPTURES:
+            MoveGen::GenLegal(board_, captures_, GEN_NOISY);
+            scoreCaptures();
+            stage_ = STAGE_GOOD_CAPTURES;
+            [[fallthrough]];
+
+        case STAGE_GOOD_CAPTURES:
+            while(captureIndex_ < captures_.size()){
+                Move move = pickBest(captures_, captureIndex_);
+                if(move != ttMove_) return move;
+            }
+            stage_ = STAGE_KILLER_1;
+            [[fallthrough]];
+
+        case STAGE_KILLER_1:
+            stage_ = STAGE_KILLER_2;
+            if(isQuietCandidate(killers_[0])) return killers_[0];
+            [[fallthrough]];
+
+        case STAGE_KILLER_2:
+            stage_ = STAGE_COUNTER_MOVE;
+            if(killers_[1] != killers_[0] && isQuietCandidate(killers_[1])) return killers_[1];
+            [[fallthrough]];
+
+        case STAGE_COUNTER_MOVE:
+            stage_ = STAGE_GEN_QUIETS;
+            if(counterMove_ != killers_[0] && counterMove_ != killers_[1] && isQuietCandidate(counterMove_)){
+                return counterMove_;
+            }
+            [[fallthrough]];
+
+        case STAGE_GEN_QUIETS:
+            MoveGen::GenLegal(board_, quiets_, GEN_QUIET);
+            scoreQuiets();
+            stage_ = STAGE_QUIETS;
+            [[fallthrough]];
+
+        case STAGE_QUIETS:
+            while(quietIndex_ < quiets_.size()){
+                Move move = pickBest(quiets_, quietIndex_);
+                if(!alreadyTried(move)) return move;
+            }
+            stage_ = STAGE_BAD_CAPTURES;
+            [[fallthrough]];
+
+        case STAGE_BAD_CAPTURES:
+            while(badCaptureIndex_ < badCaptures_.size()){
+                Move move = pickBest(badCaptures_, badCaptureIndex_);
+                if(move != ttMove_) return move;
+            }
+            stage_ = STAGE_DONE;
+            [[fallthrough]];
+
+        case STAGE_DONE:
+        default:
+            return Move();
+    }
+}
+
+// killers and counter moves come from other positions, so they are checked before use
+bool MovePicker::isQuietCandidate(const Move& move) const{
+    return !move.isNull() && move != ttMove_ && !move.isCapture() && !move.isPromotion()
+        && MoveGen::isLegal(board_, move);
+}
+
+// quiet moves handed out before the quiet stage
+bool MovePicker::alreadyTried(const Move& move) const{
+    return move == ttMove_ || move == killers_[0] || move == killers_[1] || move == counterMove_;
+}
+
+// one step of a selection sort: swap the best remaining move to index and return it
+Move MovePicker::pickBest(MoveList& list, int& index){
+    int best = index;
+    for(int i = index + 1; i < list.size(); i++){
+        if(list.scores[i] > list.scores[best]) best = i;
+    }
+    std::swap(list.moves[index], list.moves[best]);
+    std::swap(list.scores[index], list.scores[best]);
+    return list[index++];
+}
+
+// MVV-LVA. Underpromotions and captures that lose material by static exchange
+// are moved to the bad capture list and tried after the quiets.
+void MovePicker::scoreCaptures(){
+    using namespace PieceSquareTables;
+    int good = 0;
+
+    for(int i = 0; i < captures_.size(); i++){
+        Move move = captures_[i];
+        int attacker = board_.squares[move.from()];
+        int victim = board_.capturedPiece(move);
+        int score = MG_PIECE_VALUES[victim] * 8 - MG_PIECE_VALUES[attacker] / 8;
+        if(move.isPromotion()) score += MG_PIECE_VALUES[makePiece(WHITE, move.promotionType())] * 8;
+
+        bool bad = move.isPromotion() ? move.promotionType() != QUEEN : !see(board_, move, 0);
+
+        if(bad){
+            badCaptures_.scores[badCaptures_.size()] = score;
+            badCaptures_.push_back(move);
+        }
+        else{
+            captures_.scores[good] = score;
+            captures_[good++] = move;
+        }
+    }
+    captures_.resize(good);
+}
+
+void MovePicker::scoreQuiets(){
+    for(int i = 0; i < quiets_.size(); i++){
+        const Move& move = quiets_[i];
+        int score = history_ ? history_[move.from()][move.to()] : 0;
+
+        if(move.isCastling()) score += 100;
+
+        int toFile = file(move.to());
+        int toRank = rank(move.to());
+        if(toFile >= 2 && toFile <= 5 && toRank >= 2 && toRank <= 5){
+            score += 10;
+        }
+        quiets_.scores[i] = score;
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "../core/board.hpp"
+#include "../core/move.hpp"
+
+// movepicker.hpp - hands out the moves of a search node one at a time, best guess first
+// Stages: TT move, good captures, killers, counter move, quiets, bad captures.
+// A stage is only generated once the previous one is used up and each pick is one step
+// of a selection sort, so a node that cuts off early never generates or sorts its quiets.
+
+enum PickStage {
+    STAGE_TT_MOVE = 0,
+    STAGE_GEN_CAPTURES,
+    STAGE_GOOD_CAPTURES,
+    STAGE_KILLER_1,
+    STAGE_KILLER_2,
+    STAGE_COUNTER_MOVE,
+    STAGE_GEN_QUIETS,
+    STAGE_QUIETS,
+    STAGE_BAD_CAPTURES,
+    STAGE_DONE
+};
+
+class MovePicker {
+public:
+    // killers (two slots), counterMove and history (from/to scores for the side to move)
+    // may be left empty; they only change the order, never which moves are returned
+    MovePicker(const Board& board, const Move& ttMove, const Move* killers = nullptr,
+               const Move& counterMove = Move(), const int (*history)[64] = nullptr);
+
+    // next legal move, or a null move once every move has been returned
+    Move next();
+
+    int stage() const { return stage_; }
+
+private:
+    bool isQuietCandidate(const Move& move) const;
+    bool alreadyTried(const Move& move) const;
+    Move pickBest(MoveList& list, int& index);
+
+    void scoreCaptures();
+    void scoreQuiets();
+
+    const Board& board_;
+    Move ttMove_;
+    Move killers_[2];
+    Move counterMove_;
+    const int (*history_)[64];
+
+    int stage_;
+    MoveList captures_;
+    MoveList badCaptures_;
+    MoveList quiets_;
+    int captureIndex_;
+    int badCaptureIndex_;
+    int quietIndex_;
+};
@@ -0,0 +1,181 @@
+#include "pawns.hpp"
+#include "../core/utils.hpp"
+#include <algorithm>
+
+using namespace Bitboards;
+
+namespace PawnStructure {
+
+const int DOUBLED_MG = -10, DOUBLED_EG = -25;
+const int ISOLATED_MG = -10, ISOLATED_EG = -15;
+const int BACKWARD_MG = -8, BACKWARD_EG = -12;
+
+// defended or side by side, applies in both phases
+const int CONNECTED[8] = {0, 4, 6, 10, 18, 30, 50, 0};
+
+const int PASSED_MG[8] = {0, 5, 10, 15, 25, 45, 70, 0};
+const int PASSED_EG[8] = {0, 10, 18, 30, 55, 90, 140, 0};
+
+const int SHIELD_CLOSE = 12, SHIELD_FAR = 6;
+
+// enemy pawn on the king's files, by ranks in front of the king; one rank ahead it is
+// usually blocked by or trading with the shield rather than prying it open
+const int STORM[8] = {0, -5, -20, -12, -6, 0, 0, 0};
+
+static const int FORWARD[2] = {0, 4};   // RAYS direction a pawn advances in, [white, black]
+
+static Bitboard adjacentFiles(int f){
+    return (f > 0 ? FILE_A << (f - 1) : 0) | (f < 7 ? FILE_A << (f + 1) : 0);
+}
+
+static void evaluateSide(const Board& board, int us, PawnEntry& entry, int& mg, int& eg){
+    int them = us ^ 1;
+    Bitboard own = board.pieces(us, PAWN);
+    Bitboard enemy = board.pieces(them, PAWN);
+    Bitboard enemyAttacks = pawnAttacks(enemy, them);
+
+    Bitboard pawns = own;
+    while(pawns){
+        int sq = popLsb(pawns);
+        int f = file(sq);
+        int relRank = us == WHITE ? rank(sq) : 7 - rank(sq);
+        int stop = us == WHITE ? sq + 8 : sq - 8;
+
+        Bitboard adjacent = adjacentFiles(f);
+        Bitboard ahead = RAYS[FORWARD[us]][sq];
+        Bitboard aheadAdjacent = (f > 0 ? RAYS[FORWARD[us]][sq - 1] : 0)
+                               | (f < 7 ? RAYS[FORWARD[us]][sq + 1] : 0);
+
+        Bitboard supported = PAWN_ATTACKS[them][sq] & own;
+        Bitboard phalanx = adjacent & own & (RANK_1 << (8 * rank(sq)));
+
+        bool doubled = ahead & own;
+        bool isolated = !(adjacent & own);
+        // every neighbour has already gone past it and the square in front is guarded
+        bool backward = !isolated && !(own & adjacent & ~aheadAdjacent)
+                     && (enemyAttacks & squareBB(stop));
+
+        if(doubled){
+            mg += DOUBLED_MG;
+            eg += DOUBLED_EG;
+        }
+        if(isolated){
+            mg += ISOLATED_MG;
+            eg += ISOLATED_EG;
+        }
+        else if(backward){
+            mg += BACKWARD_MG;
+            eg += BACKWARD_EG;
+        }
+        if(supported | phalanx){
+            mg += CONNECTED[relRank];
+            eg += CONNECTED[relRank];
+        }
+
+        // only the front pawn of a doubled pair can be passed
+        if(!doubled && !((ahead | aheadAdjacent) & enemy)){
+            entry.passed[us] |= squareBB(sq);
+            mg += PASSED_MG[relRank];
+            eg += PASSED_EG[relRank];
+        }
+    }
+
+    entry.attacks[us] = pawnAttacks(own, us);
+}
+
+void evaluate(const Board& board, PawnEntry& entry){
+    int whiteMg = 0, whiteEg = 0, blackMg = 0, blackEg = 0;
+    entry.passed[WHITE] = entry.passed[BLACK] = 0;
+
+    evaluateSide(board, WHITE, entry, whiteMg, whiteEg);
+    evaluateSide(board, BLACK, entry, blackMg, blackEg);
+
+    entry.mgScore = whiteMg - blackMg;
+    entry.egScore = whiteEg - blackEg;
+}
+
+static int shieldSide(const Board& board, int us){
+    Bitboard king = board.pieces(us, KING);
+    if(!king) return 0;
+
+    int sq = lsb(king);
+    int relRank = us == WHITE ? rank(sq) : 7 - rank(sq);
+    // a king that has left its back two ranks has no shield to speak of
+    if(relRank > 1) return 0;
+
+    Bitboard files = (FILE_A << file(sq)) | adjacentFiles(file(sq));
+    int closeRank = us == WHITE ? rank(sq) + 1 : rank(sq) - 1;
+    int farRank = us == WHITE ? rank(sq) + 2 : rank(sq) - 2;
+    Bitboard own = board.pieces(us, PAWN) & files;
+
+    return SHIELD_CLOSE * popCount(own & (RANK_1 << (8 * closeRank)))
+         + SHIELD_FAR * popCount(own & (RANK_1 << (8 * farRank)));
+}
+
+int shield(const Board& board){
+    return shieldSide(board, WHITE) - shieldSide(board, BLACK);
+}
+
+static int stormSide(const Board& board, int us){
+    Bitboard king = board.pieces(us, KING);
+    if(!king) return 0;
+
+    int sq = lsb(king);
+    Bitboard files = (FILE_A << file(sq)) | adjacentFiles(file(sq));
+    Bitboard storming = board.pieces(us ^ 1, PAWN) & files;
+
+    int score = 0;
+    while(storming){
+        int pawn = popLsb(storming);
+        int distance = us == WHITE ? rank(pawn) - rank(sq) : rank(sq) - rank(pawn);
+        if(distance > 0) score += STORM[distance];
+    }
+    return score;
+}
+
+int storm(const Board& board){
+    return stormSide(board, WHITE) - stormSide(board, BLACK);
+}
+
+static void blockedSide(const Board& board, Bitboard passed, int us, int& mg, int& eg){
+    while(passed){
+        int sq = popLsb(passed);
+        int stop = us == WHITE ? sq + 8 : sq - 8;
+        if(board.squares[stop] == EMPTY) continue;
+
+        int relRank = us == WHITE ? rank(sq) : 7 - rank(sq);
+        mg += PASSED_MG[relRank] / 2;
+        eg += PASSED_EG[relRank] / 2;
+    }
+}
+
+void blockedPassers(const Board& board, const PawnEntry& entry, int& mg, int& eg){
+    int whiteMg = 0, whiteEg = 0, blackMg = 0, blackEg = 0;
+    blockedSide(board, entry.passed[WHITE], WHITE, whiteMg, whiteEg);
+    blockedSide(board, entry.passed[BLACK], BLACK, blackMg, blackEg);
+    mg = blackMg - whiteMg;
+    eg = blackEg - whiteEg;
+}
+
+} // namespace PawnStructure
+
+PawnTable::PawnTable(size_t entries) : entries_(entries) {}
+
+const PawnEntry& PawnTable::probe(const Board& board){
+    probes_++;
+    PawnEntry& entry = entries_[board.pawnKey & (entries_.size() - 1)];
+    if(entry.key == board.pawnKey){
+        hits_++;
+        return entry;
+    }
+
+    PawnStructure::evaluate(board, entry);
+    entry.key = board.pawnKey;
+    return entry;
+}
+
+void PawnTable::clear(){
+    std::fill(entries_.begin(), entries_.end(), PawnEntry());
+    probes_ = 0;
+    hits_ = 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "../core/board.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// pawns.hpp - pawn structure evaluation and the pawn hash table
+// Pawn terms depend on nothing but the pawns, which rarely move, so they are cached
+// under Board::pawnKey and shared by every position in the search with the same pawns.
+
+// cached result for one pawn structure, scores are white minus black
+struct PawnEntry {
+    uint64_t key = 0;
+    int mgScore = 0;
+    int egScore = 0;
+    Bitboard passed[2] = {0, 0};        // [white, black] passed pawns
+    Bitboard attacks[2] = {0, 0};       // squares attacked by each side's pawns
+};
+
+namespace PawnStructure {
+
+    // penalties are negative, bonuses indexed by rank from the pawn's own side
+    extern const int DOUBLED_MG, DOUBLED_EG;
+    extern const int ISOLATED_MG, ISOLATED_EG;
+    extern const int BACKWARD_MG, BACKWARD_EG;
+    extern const int CONNECTED[8];
+    extern const int PASSED_MG[8];
+    extern const int PASSED_EG[8];
+    extern const int SHIELD_CLOSE, SHIELD_FAR;  // middlegame only
+    extern const int STORM[8];                  // middlegame only, by ranks in front of the king
+
+    // full evaluation of the pawn structure, fills every field but key
+    void evaluate(const Board& board, PawnEntry& entry);
+
+    // King shelter terms. Both depend on the king square, so they are not cached;
+    // white minus black, middlegame only.
+    int shield(const Board& board);     // own pawns one and two ranks in front of the king
+    int storm(const Board& board);      // enemy pawns advancing on the king's files
+
+    // Passed pawns with a piece on their stop square keep only half their bonus; depends
+    // on the pieces, so it is scored from the cached passed set. White minus black.
+    void blockedPassers(const Board& board, const PawnEntry& entry, int& mg, int& eg);
+}
+
+// Direct-mapped, one table per search thread so it needs no synchronisation.
+// An empty slot has key 0 and zero scores, which is also the correct entry for a
+// position without pawns.
+class PawnTable {
+public:
+    explicit PawnTable(size_t entries = DEFAULT_ENTRIES);
+
+    const PawnEntry& probe(const Board& board);    // computes and stores the entry on a miss
+    void clear();
+
+    //Statistics
+    uint64_t getProbes() const { return probes_; }
+    uint64_t getHits() const { return hits_; }
+    double hitRate() const { return probes_ ? static_cast<double>(hits_) / probes_ : 0.0; }
+
+    static constexpr size_t DEFAULT_ENTRIES = 8192;     // must be a power of two
+
+private:
+    std::vector<PawnEntry> entries_;
+    uint64_t probes_ = 0;
+    uint64_t hits_ = 0;
+};
@@ -199,45 +199,38 @@ const int* EG_PIECE_TABLES[6] = {
     EG_ROOK_TABLE, EG_QUEEN_TABLE, EG_KING_TABLE
 };
 
-//calculate current game phase (0 = endgame, 24 = opening)
-int calculateGamePhase(const Board& board) {
-    int gamePhase = 0;
-    
-    for (int sq = 0; sq < 64; sq++) {
-        int piece = board.squares[sq];
-        if (piece != EMPTY) {
-            gamePhase += GAME_PHASE_INC[piece];
+int PSQT_MG[13][64];
+int PSQT_EG[13][64];
+
+static void initPsqt() {
+    for (int piece = B_PAWN; piece <= W_KING; piece++) {
+        bool isWhite = piece >= W_PAWN;
+        int pieceType = getPieceType(piece, isWhite);
+
+        for (int sq = 0; sq < 64; sq++) {
+            int tableSquare = isWhite ? sq : flipSquare(sq);
+            int mg = MG_PIECE_VALUES[piece] + MG_PIECE_TABLES[pieceType][tableSquare];
+            int eg = EG_PIECE_VALUES[piece] + EG_PIECE_TABLES[pieceType][tableSquare];
+            PSQT_MG[piece][sq] = isWhite ? mg : -mg;
+            PSQT_EG[piece][sq] = isWhite ? eg : -eg;
         }
     }
-    
+}
+
+// only reads the constant tables above, so it is safe to run as a static initialiser
+static const bool psqtReady = (initPsqt(), true);
+
+//current game phase (0 = endgame, 24 = opening)
+int calculateGamePhase(const Board& board) {
     // cap at 24 (max opening phase) in case of early promotions
-    return std::min(gamePhase, 24);
+    return std::min(board.phase, 24);
 }
 
 // Main tapered evaluation function
-float evaluateTapered(const Board& board) {
-    int mgScore[2] = {0, 0};  // [white, black] middlegame score
-    int egScore[2] = {0, 0};  
-    
-    for (int sq = 0; sq < 64; sq++) {
-        int piece = board.squares[sq];
-        if (piece == EMPTY) continue;
-        
-        bool isWhite = piece >= W_PAWN;
-        int color = isWhite ? 0 : 1;
-        int pieceType = getPieceType(piece, color);
-        
-        if (pieceType == -1) continue;
-        
-        int tableSquare = isWhite ? sq : flipSquare(sq);
-        
-        // Add material value + piece-square table bonus
-        mgScore[color] += MG_PIECE_VALUES[piece] + MG_PIECE_TABLES[pieceType][tableSquare];
-        egScore[color] += EG_PIECE_VALUES[piece] + EG_PIECE_TABLES[pieceType][tableSquare];
-    }
-    
-    int mgRelative = mgScore[board.whiteToMove ? 0 : 1] - mgScore[board.whiteToMove ? 1 : 0];
-    int egRelative = egScore[board.whiteToMove ? 0 : 1] - egScore[board.whiteToMove ? 1 : 0];
+Score evaluateTapered(const Board& board) {
+    // running sums are white minus black
+    int mgRelative = board.whiteToMove ? board.mgScore : -board.mgScore;
+    int egRelative = board.whiteToMove ? board.egScore : -board.egScore;
     
     // Tapered evaluation: interpolate between MG and EG based on game phase
     int gamePhase = calculateGamePhase(board);
@@ -245,7 +238,7 @@ float evaluateTapered(const Board& board) {
     int egPhase = 24 - mgPhase;
     
     // Final tapered score
-    return (mgRelative * mgPhase + egRelative * egPhase) / 24.0f;
-    }
+    return (mgRelative * mgPhase + egRelative * egPhase) / 24;
+}
 
-} // namespace PieceSquareTables
\ No newline at end of file
+} // namespace PieceSquareTables
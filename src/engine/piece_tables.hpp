@@ -1,5 +1,6 @@
 #pragma once
 #include "../core/board.hpp"  
+#include "score.hpp"
 
 // piece_tables.hpp - PeSTO's Evaluation Function Tables
 // Separate file for clean organization and easy tuning
@@ -32,6 +33,11 @@ namespace PieceSquareTables {
     // Pointer arrays for easy access
     extern const int* MG_PIECE_TABLES[6];
     extern const int* EG_PIECE_TABLES[6];
+
+    // Material + table bonus per piece and square, signed from white's point of view
+    // (black entries negative). Board keeps running sums of these, see Board::mgScore.
+    extern int PSQT_MG[13][64];
+    extern int PSQT_EG[13][64];
     
     // Utility functions 
     inline int getPieceType(int piece, bool color) {
@@ -49,5 +55,5 @@ namespace PieceSquareTables {
     
     // Main evaluation functions
     int calculateGamePhase(const Board& board);
-    float evaluateTapered(const Board& board);
+    Score evaluateTapered(const Board& board);      // O(1) from the board's running sums
 }
\ No newline at end of file
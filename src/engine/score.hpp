@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+
+// score.hpp - integer scores used by evaluation, search and the transposition table
+// Scores are centipawns from the point of view of the side to move. A forced mate is
+// SCORE_MATE minus the number of plies from the root to the mate, so shorter mates score
+// higher and every mate score fits the 16 bits a TT entry keeps for it.
+
+typedef int32_t Score;
+
+constexpr int MAX_PLY = 128;
+
+constexpr Score SCORE_DRAW = 0;
+constexpr Score SCORE_MATE = 32000;
+constexpr Score SCORE_INFINITE = 32001;
+constexpr Score SCORE_MATE_IN_MAX_PLY = SCORE_MATE - MAX_PLY;   // anything beyond is a mate
+
+inline Score mateIn(int ply) { return SCORE_MATE - ply; }      // side to move mates at ply
+inline Score matedIn(int ply) { return -SCORE_MATE + ply; }    // side to move is mated at ply
+
+inline bool isMateScore(Score score) {
+    return score >= SCORE_MATE_IN_MAX_PLY || score <= -SCORE_MATE_IN_MAX_PLY;
+}
+
+// moves to mate as a signed count, positive when the side to move mates
+inline int mateInMoves(Score score) {
+    return score > 0 ? (SCORE_MATE - score + 1) / 2 : -(SCORE_MATE + score) / 2;
+}
+
+// The table is shared between plies, so mate scores are stored as the distance from the
+// node rather than from the root and converted back when read at another ply.
+inline Score scoreToTT(Score score, int ply) {
+    if(score >= SCORE_MATE_IN_MAX_PLY) return score + ply;
+    if(score <= -SCORE_MATE_IN_MAX_PLY) return score - ply;
+    return score;
+}
+
+inline Score scoreFromTT(Score score, int ply) {
+    if(score >= SCORE_MATE_IN_MAX_PLY) return score - ply;
+    if(score <= -SCORE_MATE_IN_MAX_PLY) return score + ply;
+    return score;
+}
@@ -0,0 +1,76 @@
+#include "see.hpp"
+
+using namespace Bitboards;
+
+const int SEE_VALUES[6] = {100, 320, 330, 500, 900, 20000};
+
+bool see(const Board& board, const Move& move, int threshold){
+    // castling, en passant and promotions are scored as an even trade
+    if(move.isCastling() || move.isEnPassant() || move.isPromotion()) return 0 >= threshold;
+
+    int from = move.from();
+    int to = move.to();
+
+    // swap tracks the balance against the threshold from the point of view of the side
+    // about to decide; a side stops capturing as soon as carrying on can't help it
+    int captured = board.squares[to];
+    int swap = (captured == EMPTY ? 0 : SEE_VALUES[pieceType(captured)]) - threshold;
+    if(swap < 0) return false;
+
+    swap = SEE_VALUES[pieceType(board.squares[from])] - swap;
+    if(swap <= 0) return true;
+
+    Bitboard occupancy = board.occupied ^ squareBB(from) ^ squareBB(to);
+    Bitboard attackers = board.attackersTo(to, occupancy);
+    Bitboard bishopsQueens = board.pieceBB[W_BISHOP] | board.pieceBB[B_BISHOP]
+                           | board.pieceBB[W_QUEEN] | board.pieceBB[B_QUEEN];
+    Bitboard rooksQueens = board.pieceBB[W_ROOK] | board.pieceBB[B_ROOK]
+                         | board.pieceBB[W_QUEEN] | board.pieceBB[B_QUEEN];
+
+    int side = board.whiteToMove ? WHITE : BLACK;
+    int result = 1;
+
+    while(true){
+        side ^= 1;
+        attackers &= occupancy;
+
+        Bitboard sideAttackers = attackers & board.colourBB[side];
+        if(!sideAttackers) break;
+
+        result ^= 1;
+
+        // least valuable attacker captures next; removing it may uncover a slider behind
+        Bitboard bb;
+        if((bb = sideAttackers & board.pieces(side, PAWN))){
+            if((swap = SEE_VALUES[PAWN] - swap) < result) break;
+            occupancy ^= squareBB(lsb(bb));
+            attackers |= bishopAttacks(to, occupancy) & bishopsQueens;
+        }
+        else if((bb = sideAttackers & board.pieces(side, KNIGHT))){
+            if((swap = SEE_VALUES[KNIGHT] - swap) < result) break;
+            occupancy ^= squareBB(lsb(bb));
+        }
+        else if((bb = sideAttackers & board.pieces(side, BISHOP))){
+            if((swap = SEE_VALUES[BISHOP] - swap) < result) break;
+            occupancy ^= squareBB(lsb(bb));
+            attackers |= bishopAttacks(to, occupancy) & bishopsQueens;
+        }
+        else if((bb = sideAttackers & board.pieces(side, ROOK))){
+            if((swap = SEE_VALUES[ROOK] - swap) < result) break;
+            occupancy ^= squareBB(lsb(bb));
+            attackers |= rookAttacks(to, occupancy) & rooksQueens;
+        }
+        else if((bb = sideAttackers & board.pieces(side, QUEEN))){
+            if((swap = SEE_VALUES[QUEEN] - swap) < result) break;
+            occupancy ^= squareBB(lsb(bb));
+            attackers |= (bishopAttacks(to, occupancy) & bishopsQueens)
+                       | (rookAttacks(to, occupancy) & rooksQueens);
+        }
+        else{
+            // the king may only take last, when nothing of the other side still attacks
+            return (attackers & ~board.colourBB[side]) ? result ^ 1 : result;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include "../core/board.hpp"
+#include "../core/move.hpp"
+
+// see.hpp - static exchange evaluation
+// Plays out the full capture sequence on the target square, cheapest attacker first,
+// with sliders behind the pieces that have captured joining in (x-rays).
+
+// piece values used for exchanges, indexed by PieceType
+extern const int SEE_VALUES[6];
+
+// true when the exchange started by move wins at least threshold centipawns
+bool see(const Board& board, const Move& move, int threshold);
@@ -0,0 +1,121 @@
+#include "transposition.hpp"
+#include <algorithm>
+#include <climits>
+
+static constexpr int GENERATION_MASK = 0x3F;
+
+static uint16_t keyTag(uint64_t key) { return static_cast<uint16_t>(key >> 48); }
+
+static uint64_t packEntry(uint64_t key, const Move& move, Score score, int depth, int flag, int generation){
+    return static_cast<uint64_t>(move.data)
+         | static_cast<uint64_t>(static_cast<uint16_t>(score)) << 16
+         | static_cast<uint64_t>(std::min(std::max(depth, 0), 255)) << 32
+         | static_cast<uint64_t>(flag) << 40
+         | static_cast<uint64_t>(generation) << 42
+         | static_cast<uint64_t>(keyTag(key)) << 48;
+}
+
+static Move entryMove(uint64_t data) {
+    Move move;
+    move.data = static_cast<uint16_t>(data & 0xFFFF);
+    return move;
+}
+
+static Score entryScore(uint64_t data) { return static_cast<int16_t>((data >> 16) & 0xFFFF); }
+static int entryDepth(uint64_t data) { return static_cast<int>((data >> 32) & 0xFF); }
+static int entryFlag(uint64_t data) { return static_cast<int>((data >> 40) & 0x3); }
+static int entryGeneration(uint64_t data) { return static_cast<int>((data >> 42) & GENERATION_MASK); }
+static bool entryMatches(uint64_t data, uint64_t key) {
+    return static_cast<uint16_t>(data >> 48) == keyTag(key) && entryFlag(data) != TT_NONE;
+}
+
+TranspositionTable::TranspositionTable(size_t megabytes) : indexMask_(0), generation_(0) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes){
+    // largest power-of-two bucket count that fits the budget
+    size_t budget = std::max<size_t>(megabytes, 1) * 1024 * 1024 / sizeof(TTBucket);
+    size_t bucketCount = 1;
+    while(bucketCount * 2 <= budget) bucketCount *= 2;
+
+    buckets_ = std::vector<TTBucket>(bucketCount);
+    indexMask_ = bucketCount - 1;
+    clear();
+}
+
+void TranspositionTable::clear(){
+    for(TTBucket& bucket : buckets_){
+        for(TTEntry& entry : bucket.entries){
+            entry.write(0);
+        }
+    }
+    generation_ = 0;
+}
+
+void TranspositionTable::newSearch(){
+    generation_ = (generation_ + 1) & GENERATION_MASK;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTData& out){
+    for(TTEntry& entry : bucketFor(key).entries){
+        uint64_t data = entry.load();
+        if(!entryMatches(data, key)) continue;
+
+        // touched this search, so keep it ahead of stale entries
+        if(entryGeneration(data) != generation_){
+            data = (data & ~(static_cast<uint64_t>(GENERATION_MASK) << 42))
+                 | static_cast<uint64_t>(generation_) << 42;
+            entry.write(data);
+        }
+
+        out.move = entryMove(data);
+        out.score = entryScore(data);
+        out.depth = entryDepth(data);
+        out.flag = entryFlag(data);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, Score score, int depth, int flag, const Move& bestMove){
+    TTBucket& bucket = bucketFor(key);
+    TTEntry* replace = &bucket.entries[0];
+    int lowestValue = INT_MAX;
+
+    for(TTEntry& entry : bucket.entries){
+        uint64_t data = entry.load();
+
+        if(entryMatches(data, key)){
+            // same position: a much shallower bound is not worth losing the deeper result for
+            if(flag != TT_EXACT && depth + 2 < entryDepth(data) && entryGeneration(data) == generation_) return;
+
+            Move move = bestMove.isNull() ? entryMove(data) : bestMove;
+            entry.write(packEntry(key, move, score, depth, flag, generation_));
+            return;
+        }
+
+        // empty slots go first, then shallow entries and entries from older searches
+        int age = (generation_ - entryGeneration(data)) & GENERATION_MASK;
+        int value = entryFlag(data) == TT_NONE ? INT_MIN : entryDepth(data) - 8 * age;
+        if(value < lowestValue){
+            lowestValue = value;
+            replace = &entry;
+        }
+    }
+
+    replace->write(packEntry(key, bestMove, score, depth, flag, generation_));
+}
+
+int TranspositionTable::hashfull() const{
+    size_t sampleBuckets = std::min<size_t>(250, buckets_.size());
+    int used = 0;
+
+    for(size_t i = 0; i < sampleBuckets; i++){
+        for(const TTEntry& entry : buckets_[i].entries){
+            uint64_t data = entry.load();
+            if(entryFlag(data) != TT_NONE && entryGeneration(data) == generation_) used++;
+        }
+    }
+    return static_cast<int>(used * 1000 / (sampleBuckets * TTBucket::SIZE));
+}
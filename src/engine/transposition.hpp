@@ -0,0 +1,72 @@
+#pragma once
+#include "../core/move.hpp"
+#include "score.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// transposition.hpp - fixed-size hash table of search results
+// The table is a power-of-two array of 64-byte buckets (one cache line each),
+// every bucket holding eight entries. A position probes exactly one bucket.
+
+enum TTFlag {
+    TT_NONE = 0,
+    TT_EXACT,           // score is exact
+    TT_LOWER,           // score is a lower bound (fail high)
+    TT_UPPER            // score is an upper bound (fail low)
+};
+
+// Entry packed into one word:
+// bits 0-15 move, 16-31 score, 32-39 depth, 40-41 flag, 42-47 generation, 48-63 key.
+// The low key bits already chose the bucket, the entry keeps the top 16 to tell the
+// positions sharing it apart. A different position that agrees on both still matches;
+// its move is checked for legality before it is played, but its score and bound can
+// cause a wrong cutoff. Eight 16-bit tags per bucket make that about one probe in 8192
+// of a position the bucket doesn't hold, and one bad cutoff seldom changes the move at
+// the root, so it is worth the smaller entry. Search threads share the table without
+// locks, and since an entry is a single relaxed atomic word it can never be read half
+// written.
+struct TTEntry {
+    std::atomic<uint64_t> word;
+
+    uint64_t load() const { return word.load(std::memory_order_relaxed); }
+    void write(uint64_t w) { word.store(w, std::memory_order_relaxed); }
+};
+
+struct alignas(64) TTBucket {
+    static constexpr int SIZE = 8;
+    TTEntry entries[SIZE];
+};
+
+static_assert(sizeof(TTBucket) == 64, "a bucket must fill exactly one cache line");
+
+// decoded entry handed back by probe()
+struct TTData {
+    Move move;
+    Score score;        // as stored, mate scores relative to the node (see scoreToTT)
+    int depth;
+    int flag;
+};
+
+class TranspositionTable {
+public:
+    explicit TranspositionTable(size_t megabytes = 16);
+
+    void resize(size_t megabytes);
+    void clear();           // wipe all entries, e.g. between games
+    void newSearch();       // age existing entries so they are replaced first
+
+    bool probe(uint64_t key, TTData& out);
+    void store(uint64_t key, Score score, int depth, int flag, const Move& bestMove);
+
+    //Statistics
+    int hashfull() const;   // permille of sampled entries written in the current search
+
+private:
+    std::vector<TTBucket> buckets_;
+    uint64_t indexMask_;
+    uint8_t generation_;
+
+    TTBucket& bucketFor(uint64_t key) { return buckets_[key & indexMask_]; }
+};
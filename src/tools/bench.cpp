@@ -0,0 +1,148 @@
+#include "core/board.hpp"
+#include "core/fen_reader.hpp"
+#include "core/perft.hpp"
+#include "engine/engine.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+// bench [perft|search|smp] [depth]
+//   perft  - perft from the start position, reports nodes per second
+//   search - fixed-depth engine search from the start position
+//   smp    - the same search at 1, 2, 4, 8 and 16 threads, reports time to depth and nps
+// bench fen <file>
+//   loads every position of a one-FEN-per-line file, reports positions per second
+// perft and search report how many heap allocations the run made.
+
+static std::atomic<uint64_t> allocations{0};
+
+void* operator new(std::size_t size){
+    allocations++;
+    if(void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept{
+    std::free(p);
+}
+
+static void report(uint64_t nodes, double seconds, uint64_t allocs){
+    uint64_t nps = seconds > 0 ? static_cast<uint64_t>(nodes / seconds) : 0;
+    std::cout << nodes << " nodes in " << static_cast<int>(seconds * 1000) << "ms ("
+              << nps << " nps), " << allocs << " allocations ("
+              << (nodes ? static_cast<double>(allocs) / nodes : 0.0) << " per node)\n";
+}
+
+static void benchPerft(int maxDepth){
+    Board board;
+    board.setStartPos();
+
+    for(int depth = 1; depth <= maxDepth; depth++){
+        uint64_t allocsBefore = allocations;
+        auto start = std::chrono::steady_clock::now();
+        uint64_t nodes = perft(board, depth);
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << "perft " << depth << ": ";
+        report(nodes, std::chrono::duration<double>(end - start).count(), allocations - allocsBefore);
+    }
+}
+
+static void benchSearch(int depth){
+    Board board;
+    board.setStartPos();
+    ChessEngine engine(EngineLevel::EXPERT);
+
+    uint64_t allocsBefore = allocations;
+    auto start = std::chrono::steady_clock::now();
+    Move best = engine.getBestMove(board, depth, 1000000);
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "search depth " << depth << ": best " << best.toString() << ", ";
+    report(engine.getNodesSearched(), std::chrono::duration<double>(end - start).count(), allocations - allocsBefore);
+    std::cout << "tt hit rate " << static_cast<int>(engine.getTTHitRate() * 100) << "%, hashfull "
+              << engine.getHashfull() << ", pawn hit rate "
+              << static_cast<int>(engine.getPawnHitRate() * 100) << "%\n";
+}
+
+static void benchSmp(int depth){
+    Board board;
+    board.setStartPos();
+
+    double baseSeconds = 0;
+    for(int threads : {1, 2, 4, 8, 16}){
+        // fresh engine each run so no thread count profits from an earlier table
+        ChessEngine engine(EngineLevel::EXPERT);
+        engine.setThreads(threads);
+
+        auto start = std::chrono::steady_clock::now();
+        Move best = engine.getBestMove(board, depth, 1000000);
+        auto end = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        if(threads == 1) baseSeconds = seconds;
+        uint64_t nodes = engine.getNodesSearched();
+        uint64_t nps = seconds > 0 ? static_cast<uint64_t>(nodes / seconds) : 0;
+
+        std::cout << threads << " threads: depth " << engine.getLastDepth() << " in "
+                  << static_cast<int>(seconds * 1000) << "ms (" << (seconds > 0 ? baseSeconds / seconds : 0.0)
+                  << "x), " << nodes << " nodes, " << nps << " nps, best " << best.toString() << "\n";
+    }
+}
+
+static int benchFen(const char* path){
+    FenReader reader(path);
+    if(!reader.isOpen()){
+        std::cout << "cannot open " << path << "\n";
+        return 1;
+    }
+
+    Board board;
+    FenError error;
+    uint64_t positions = 0, rejected = 0;
+    auto start = std::chrono::steady_clock::now();
+    while(reader.next(board, error)){
+        positions++;
+        if(error != FEN_OK) rejected++;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << positions << " positions (" << rejected << " rejected) in " << static_cast<int>(seconds * 1000)
+              << "ms, " << (seconds > 0 ? static_cast<uint64_t>(positions / seconds) : 0) << " per second\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]){
+    std::string mode = argc > 1 ? argv[1] : "perft";
+    if(mode == "fen"){
+        if(argc < 3){
+            std::cout << "usage: bench fen <file>\n";
+            return 1;
+        }
+        return benchFen(argv[2]);
+    }
+
+    int depth = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    if(mode == "perft"){
+        benchPerft(depth);
+    }
+    else if(mode == "search"){
+        benchSearch(depth);
+    }
+    else if(mode == "smp"){
+        benchSmp(depth);
+    }
+    else{
+        std::cout << "usage: bench [perft|search|smp] [depth]\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "core/board.hpp"
+#include "core/perft.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// perft <depth> [fen]
+//   node count for the position (start position by default), divided by root move
+// perft suite [max depth]
+//   runs the standard positions against their known counts, exits non-zero on a mismatch
+
+static double secondsSince(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void printSpeed(uint64_t nodes, double seconds){
+    uint64_t nps = seconds > 0 ? static_cast<uint64_t>(nodes / seconds) : 0;
+    std::cout << static_cast<int>(seconds * 1000) << "ms, " << nps << " nps\n";
+}
+
+static int runDivide(Board& board, int depth){
+    auto start = std::chrono::steady_clock::now();
+    uint64_t total = 0;
+
+    MoveList moves = board.generateLegalMoves();
+    for(const Move& move : moves){
+        UndoInfo undo = board.makeMove(move);
+        uint64_t nodes = perft(board, depth - 1);
+        board.unmakeMove(move, undo);
+
+        std::cout << move.toString() << ": " << nodes << "\n";
+        total += nodes;
+    }
+
+    std::cout << "\n" << moves.size() << " moves, " << total << " nodes\n";
+    printSpeed(total, secondsSince(start));
+    return 0;
+}
+
+static int runSuite(int maxDepth){
+    int failures = 0;
+    uint64_t totalNodes = 0;
+    auto suiteStart = std::chrono::steady_clock::now();
+
+    for(int i = 0; i < PERFT_SUITE_SIZE; i++){
+        const PerftPosition& pos = PERFT_SUITE[i];
+        Board board;
+        board.fromFEN(pos.fen);
+
+        for(int depth = 1; depth <= pos.depths && depth <= maxDepth; depth++){
+            auto start = std::chrono::steady_clock::now();
+            uint64_t nodes = perft(board, depth);
+            double seconds = secondsSince(start);
+            totalNodes += nodes;
+
+            bool ok = nodes == pos.nodes[depth - 1];
+            if(!ok) failures++;
+
+            std::cout << pos.name << " depth " << depth << ": " << nodes
+                      << (ok ? " ok, " : " FAILED (expected " + std::to_string(pos.nodes[depth - 1]) + "), ");
+            printSpeed(nodes, seconds);
+        }
+    }
+
+    std::cout << "\n" << failures << " failures, " << totalNodes << " nodes, ";
+    printSpeed(totalNodes, secondsSince(suiteStart));
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char* argv[]){
+    if(argc < 2){
+        std::cout << "usage: perft <depth> [fen]\n       perft suite [max depth]\n";
+        return 1;
+    }
+
+    std::string first = argv[1];
+    if(first == "suite"){
+        return runSuite(argc > 2 ? std::atoi(argv[2]) : 4);
+    }
+
+    int depth = std::atoi(argv[1]);
+    if(depth < 1){
+        std::cout << "depth must be at least 1\n";
+        return 1;
+    }
+
+    // the FEN may arrive as one quoted argument or split on its spaces
+    std::string fen;
+    for(int i = 2; i < argc; i++){
+        if(i > 2) fen += " ";
+        fen += argv[i];
+    }
+
+    Board board;
+    if(fen.empty()){
+        board.setStartPos();
+    }
+    else if(FenError error = board.fromFEN(fen)){
+        std::cout << "invalid FEN (" << fenErrorString(error) << "): " << fen << "\n";
+        return 1;
+    }
+
+    return runDivide(board, depth);
+}
@@ -0,0 +1,196 @@
+#include <catch2/catch_test_macros.hpp>
+#include "src/core/board.hpp"
+#include "src/core/perft.hpp"
+#include "src/engine/piece_tables.hpp"
+#include "src/engine/pawns.hpp"
+#include "src/engine/eval_info.hpp"
+
+// Test 1: running material/PST sums and phase match a full recompute through make/unmake
+// Test 2: the tapered score is symmetric and follows the side to move
+// Test 3: pawn terms spot passed, doubled, isolated and backward pawns and are colour symmetric,
+//         a blockaded passer loses half its bonus
+// Test 4: the pawn table hits on a repeated pawn structure and ignores piece moves
+// Test 5: eval attack maps agree with isSquareAttacked, also when the pawn attacks come from
+//         the pawn table, and count king zone attackers
+// Test 6: mobility skips squares covered by enemy pawns and is balanced at the start
+
+
+static void requireEvalTermsMatch(const Board& board){
+    int mg, eg, phase;
+    board.computeEvalTerms(mg, eg, phase);
+    REQUIRE( board.mgScore == mg );
+    REQUIRE( board.egScore == eg );
+    REQUIRE( board.phase == phase );
+    REQUIRE( board.pawnKey == board.computePawnKey() );
+}
+
+// walks the move tree two plies deep, checking the sums at every node
+static void walk(Board& board, int depth){
+    requireEvalTermsMatch(board);
+    if(depth == 0) return;
+
+    for(const Move& move : board.generateLegalMoves()){
+        UndoInfo undo = board.makeMove(move);
+        walk(board, depth - 1);
+        board.unmakeMove(move, undo);
+    }
+    requireEvalTermsMatch(board);
+}
+
+TEST_CASE( "incremental evaluation terms match a full recompute", "[eval]" ) {
+
+    for(int i = 0; i < PERFT_SUITE_SIZE; i++){
+        Board board;
+        REQUIRE( board.fromFEN(PERFT_SUITE[i].fen) == FEN_OK );
+        walk(board, 2);
+    }
+}
+
+TEST_CASE( "tapered evaluation is relative to the side to move", "[eval]" ) {
+
+    Board board;
+    board.setStartPos();
+    REQUIRE( board.phase == 24 );
+    REQUIRE( PieceSquareTables::evaluateTapered(board) == 0 );
+
+    // white a knight up
+    REQUIRE( board.fromFEN("r1bqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1") == FEN_OK );
+    Score white = PieceSquareTables::evaluateTapered(board);
+    REQUIRE( white > 0 );
+
+    REQUIRE( board.fromFEN("r1bqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR b KQkq - 0 1") == FEN_OK );
+    REQUIRE( PieceSquareTables::evaluateTapered(board) == -white );
+}
+
+TEST_CASE( "pawn structure terms", "[eval]" ) {
+
+    Board board;
+    PawnEntry entry;
+
+    // passed d5, doubled isolated b-pawns of which only the front one is passed
+    REQUIRE( board.fromFEN("4k3/8/8/3P4/8/1P6/1P6/4K3 w - - 0 1") == FEN_OK );
+    PawnStructure::evaluate(board, entry);
+    REQUIRE( entry.passed[WHITE] == (Bitboards::squareBB(35) | Bitboards::squareBB(17)) );
+    REQUIRE( entry.passed[BLACK] == 0 );
+
+    // the same pawns without the doubling score better
+    PawnEntry healthy;
+    REQUIRE( board.fromFEN("4k3/8/8/3P4/8/1P6/2P5/4K3 w - - 0 1") == FEN_OK );
+    PawnStructure::evaluate(board, healthy);
+    REQUIRE( healthy.mgScore > entry.mgScore );
+    REQUIRE( healthy.egScore > entry.egScore );
+
+    // d3 is left behind by c4 and e5 guards d4; with the black pawn on e6 it is not backward
+    PawnEntry backward;
+    REQUIRE( board.fromFEN("4k3/8/8/4p3/2P5/3P4/8/4K3 w - - 0 1") == FEN_OK );
+    PawnStructure::evaluate(board, backward);
+    PawnEntry free;
+    REQUIRE( board.fromFEN("4k3/8/4p3/8/2P5/3P4/8/4K3 w - - 0 1") == FEN_OK );
+    PawnStructure::evaluate(board, free);
+    REQUIRE( free.mgScore - backward.mgScore == -PawnStructure::BACKWARD_MG );
+    REQUIRE( free.egScore - backward.egScore == -PawnStructure::BACKWARD_EG );
+
+    // mirroring the colours negates every term
+    PawnEntry white, black;
+    REQUIRE( board.fromFEN("6k1/5ppp/8/2p5/1pP5/1P6/P4PPP/6K1 w - - 0 1") == FEN_OK );
+    PawnStructure::evaluate(board, white);
+    int whiteShield = PawnStructure::shield(board);
+    int whiteStorm = PawnStructure::storm(board);
+    REQUIRE( board.fromFEN("6k1/p4ppp/1p6/1Pp5/2P5/8/5PPP/6K1 w - - 0 1") == FEN_OK );
+    PawnStructure::evaluate(board, black);
+    REQUIRE( white.mgScore == -black.mgScore );
+    REQUIRE( white.egScore == -black.egScore );
+    REQUIRE( whiteShield == -PawnStructure::shield(board) );
+    REQUIRE( whiteStorm == -PawnStructure::storm(board) );
+
+    // a black knight in front of the d5 passer halves its bonus
+    PawnEntry passer;
+    int mg, eg;
+    REQUIRE( board.fromFEN("4k3/8/3n4/3P4/8/8/8/4K3 w - - 0 1") == FEN_OK );
+    PawnStructure::evaluate(board, passer);
+    PawnStructure::blockedPassers(board, passer, mg, eg);
+    REQUIRE( mg == -PawnStructure::PASSED_MG[4] / 2 );
+    REQUIRE( eg == -PawnStructure::PASSED_EG[4] / 2 );
+    REQUIRE( board.fromFEN("4k3/8/8/3P4/8/8/8/3nK3 w - - 0 1") == FEN_OK );
+    PawnStructure::blockedPassers(board, passer, mg, eg);
+    REQUIRE( mg == 0 );
+    REQUIRE( eg == 0 );
+}
+
+static void play(Board& board, const std::string& text){
+    board.makeMove(board.findMatchingMove(board.generateLegalMoves(), board.parseMove(text, true)));
+}
+
+TEST_CASE( "pawn table caches by pawn structure", "[eval]" ) {
+
+    Board board;
+    board.setStartPos();
+    PawnTable table;
+
+    PawnEntry fresh;
+    PawnStructure::evaluate(board, fresh);
+    REQUIRE( table.probe(board).mgScore == fresh.mgScore );
+    REQUIRE( table.getHits() == 0 );
+
+    // a knight move leaves the pawns alone
+    uint64_t pawnKey = board.pawnKey;
+    play(board, "g1f3");
+    REQUIRE( board.pawnKey == pawnKey );
+    table.probe(board);
+    REQUIRE( table.getHits() == 1 );
+
+    play(board, "e7e5");
+    REQUIRE( board.pawnKey != pawnKey );
+    table.probe(board);
+    REQUIRE( table.getHits() == 1 );
+    REQUIRE( table.getProbes() == 3 );
+}
+
+TEST_CASE( "eval attack maps", "[eval]" ) {
+
+    for(int i = 0; i < PERFT_SUITE_SIZE; i++){
+        Board board;
+        REQUIRE( board.fromFEN(PERFT_SUITE[i].fen) == FEN_OK );
+        EvalInfo info(board);
+
+        for(int sq = 0; sq < 64; sq++){
+            bool white = info.attacked[WHITE] & Bitboards::squareBB(sq);
+            bool black = info.attacked[BLACK] & Bitboards::squareBB(sq);
+            REQUIRE( white == board.isSquareAttacked(sq, true) );
+            REQUIRE( black == board.isSquareAttacked(sq, false) );
+        }
+
+        PawnEntry pawns;
+        PawnStructure::evaluate(board, pawns);
+        EvalInfo seeded(board, pawns);
+        REQUIRE( seeded.attacked[WHITE] == info.attacked[WHITE] );
+        REQUIRE( seeded.attacked[BLACK] == info.attacked[BLACK] );
+        REQUIRE( seeded.mobilityMg[WHITE] == info.mobilityMg[WHITE] );
+    }
+
+    // queen on h5 and knight on g5 both bear down on the castled black king
+    Board board;
+    REQUIRE( board.fromFEN("r1bq1rk1/pppp1ppp/2n2n2/4p1NQ/2B1P3/8/PPPP1PPP/RNB1K2R w KQ - 0 1") == FEN_OK );
+    EvalInfo info(board);
+    REQUIRE( info.kingAttackers[WHITE] >= 2 );
+    REQUIRE( info.kingAttackUnits[WHITE] > info.kingAttackUnits[BLACK] );
+}
+
+TEST_CASE( "mobility from attack maps", "[eval]" ) {
+
+    Board board;
+    board.setStartPos();
+    EvalInfo start(board);
+    REQUIRE( start.mobilityMg[WHITE] == start.mobilityMg[BLACK] );
+    REQUIRE( start.mobilityEg[WHITE] == start.mobilityEg[BLACK] );
+
+    // a centralised knight reaches all eight squares
+    REQUIRE( board.fromFEN("4k3/8/8/8/4N3/8/8/4K3 w - - 0 1") == FEN_OK );
+    EvalInfo free(board);
+    REQUIRE( free.mobilityMg[WHITE] == (8 - MOBILITY_BASE[KNIGHT]) * MOBILITY_MG[KNIGHT] );
+
+    // e7 covers d6 and f6
+    REQUIRE( board.fromFEN("4k3/4p3/8/8/4N3/8/8/4K3 w - - 0 1") == FEN_OK );
+    EvalInfo covered(board);
+    REQUIRE( covered.mobilityMg[WHITE] == (6 - MOBILITY_BASE[KNIGHT]) * MOBILITY_MG[KNIGHT] );
+}
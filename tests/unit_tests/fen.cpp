@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include "src/core/board.hpp"
+#include "src/core/fen_reader.hpp"
+#include "src/core/perft.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+
+// Test 1: FENs survive a fromFEN/toFEN round trip and load the same hash as play, unusable
+//         castling rights are dropped
+// Test 2: malformed FENs are rejected with the matching error and leave the board alone
+// Test 3: FenReader walks a file line by line, skipping blank lines and reporting bad ones
+
+
+TEST_CASE( "fromFEN round trips through toFEN", "[fen]" ) {
+
+    Board board;
+    for(int i = 0; i < PERFT_SUITE_SIZE; i++){
+        REQUIRE( board.fromFEN(PERFT_SUITE[i].fen) == FEN_OK );
+        REQUIRE( board.toFEN() == PERFT_SUITE[i].fen );
+        REQUIRE( board.hashKey == board.computeHash() );
+    }
+
+    REQUIRE( board.fromFEN("rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 3") == FEN_OK );
+    REQUIRE( board.enPassantSquare == 20 );
+    REQUIRE( !board.whiteToMove );
+    REQUIRE( board.fullMoveNumber == 3 );
+
+    // clocks are optional
+    REQUIRE( board.fromFEN("4k3/8/8/8/8/8/8/4K3 w - -") == FEN_OK );
+    REQUIRE( board.halfmoveClock == 0 );
+    REQUIRE( board.fullMoveNumber == 1 );
+
+    Board played;
+    played.setStartPos();
+    played.makeMove(played.findMatchingMove(played.generateLegalMoves(), played.parseMove("e2e4", true)));
+    REQUIRE( board.fromFEN(played.toFEN()) == FEN_OK );
+    REQUIRE( board.hashKey == played.hashKey );
+
+    // castling rights without the king and rook at home are dropped, so the position
+    // hashes the same as with '-' and survives the round trip
+    REQUIRE( board.fromFEN("4k3/8/8/8/8/8/8/4K3 w - - 0 1") == FEN_OK );
+    uint64_t bare = board.hashKey;
+    REQUIRE( board.fromFEN("4k3/8/8/8/8/8/8/4K3 w KQkq - 0 1") == FEN_OK );
+    REQUIRE( board.hashKey == bare );
+    REQUIRE( board.toFEN() == "4k3/8/8/8/8/8/8/4K3 w - - 0 1" );
+    REQUIRE( board.fromFEN("r3k3/8/8/8/8/8/8/4K2R w KQkq - 0 1") == FEN_OK );
+    REQUIRE( board.toFEN() == "r3k3/8/8/8/8/8/8/4K2R w Kq - 0 1" );
+}
+
+TEST_CASE( "fromFEN rejects malformed positions", "[fen]" ) {
+
+    Board board;
+    board.setStartPos();
+    std::string start = board.toFEN();
+
+    REQUIRE( board.fromFEN("") == FEN_BAD_PLACEMENT );
+    REQUIRE( board.fromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1") == FEN_BAD_PLACEMENT );
+    REQUIRE( board.fromFEN("rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1") == FEN_BAD_PLACEMENT );
+    REQUIRE( board.fromFEN("rnbqkbnr/ppppxppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1") == FEN_BAD_PLACEMENT );
+    REQUIRE( board.fromFEN("rnbqqbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1") == FEN_BAD_KINGS );
+    REQUIRE( board.fromFEN("rnbqkbnP/pppppppp/8/8/8/8/PPPPPPP1/RNBQKBNR w KQkq - 0 1") == FEN_BAD_PAWNS );
+    REQUIRE( board.fromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1") == FEN_BAD_SIDE );
+    REQUIRE( board.fromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KKkq - 0 1") == FEN_BAD_CASTLING );
+    REQUIRE( board.fromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e3 0 1") == FEN_BAD_EN_PASSANT );
+    REQUIRE( board.fromFEN("4k3/8/3n4/3pP3/8/8/8/4K3 w - d6 0 1") == FEN_BAD_EN_PASSANT );
+    REQUIRE( board.fromFEN("4k3/3n4/8/3pP3/8/8/8/4K3 w - d6 0 1") == FEN_BAD_EN_PASSANT );
+    REQUIRE( board.fromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - x 1") == FEN_BAD_CLOCKS );
+    REQUIRE( board.fromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1 extra") == FEN_BAD_CLOCKS );
+    REQUIRE( board.fromFEN("4k3/8/8/8/8/8/4R3/4K3 w - - 0 1") == FEN_BAD_CHECK );
+
+    REQUIRE( board.toFEN() == start );
+}
+
+// a uniquely named file in the temp directory, removed again even when a REQUIRE fails
+struct TempFile {
+    std::filesystem::path path;
+
+    TempFile() {
+        std::random_device rd;
+        path = std::filesystem::temp_directory_path()
+             / ("fen_reader_test_" + std::to_string(rd()) + std::to_string(rd()) + ".fen");
+    }
+    ~TempFile() {
+        std::error_code ignored;
+        std::filesystem::remove(path, ignored);
+    }
+};
+
+TEST_CASE( "FenReader loads every line of a file", "[fen]" ) {
+
+    TempFile temp;
+    std::string path = temp.path.string();
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    REQUIRE( file != nullptr );
+    std::fputs("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1\r\n"
+               "\n"
+               "not a fen\n"
+               "4k3/8/8/8/8/8/8/4K3 b - - 5 40", file);
+    std::fclose(file);
+
+    FenReader reader(path.c_str());
+    REQUIRE( reader.isOpen() );
+
+    Board board;
+    FenError error;
+    REQUIRE( reader.next(board, error) );
+    REQUIRE( error == FEN_OK );
+    REQUIRE( board.toFEN() == "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1" );
+
+    REQUIRE( reader.next(board, error) );
+    REQUIRE( error != FEN_OK );
+    REQUIRE( reader.lineNumber() == 3 );
+
+    REQUIRE( reader.next(board, error) );
+    REQUIRE( error == FEN_OK );
+    REQUIRE( board.toFEN() == "4k3/8/8/8/8/8/8/4K3 b - - 5 40" );
+
+    REQUIRE( !reader.next(board, error) );
+}
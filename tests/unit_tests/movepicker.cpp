@@ -0,0 +1,82 @@
+#include <catch2/catch_test_macros.hpp>
+#include "src/core/board.hpp"
+#include "src/core/perft.hpp"
+#include "src/engine/movepicker.hpp"
+#include <algorithm>
+#include <vector>
+
+// Test 1: the picker returns every legal move exactly once, whatever hints it is given
+// Test 2: TT move first, then captures, killers before the remaining quiets
+// Test 3: hints that are illegal in the position are skipped
+
+
+static std::vector<uint16_t> pickAll(MovePicker& picker){
+    std::vector<uint16_t> moves;
+    for(Move move = picker.next(); !move.isNull(); move = picker.next()){
+        moves.push_back(move.data);
+    }
+    return moves;
+}
+
+static std::vector<uint16_t> legalMoves(const Board& board){
+    std::vector<uint16_t> moves;
+    for(const Move& move : board.generateLegalMoves()){
+        moves.push_back(move.data);
+    }
+    return moves;
+}
+
+TEST_CASE( "move picker yields exactly the legal moves", "[movepicker]" ) {
+
+    for(int i = 0; i < PERFT_SUITE_SIZE; i++){
+        Board board;
+        REQUIRE( board.fromFEN(PERFT_SUITE[i].fen) == FEN_OK );
+
+        std::vector<uint16_t> expected = legalMoves(board);
+        MoveList list = board.generateLegalMoves();
+        Move killers[2] = {list[list.size() - 1], list[list.size() / 2]};
+
+        MovePicker picker(board, list[0], killers, list[1]);
+        std::vector<uint16_t> picked = pickAll(picker);
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(picked.begin(), picked.end());
+        REQUIRE( picked == expected );
+    }
+}
+
+TEST_CASE( "move picker orders the stages", "[movepicker]" ) {
+
+    Board board;
+    REQUIRE( board.fromFEN("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1") == FEN_OK );
+
+    Move ttMove = board.findMatchingMove(board.generateLegalMoves(), board.parseMove("a2a3", true));
+    Move killer = board.findMatchingMove(board.generateLegalMoves(), board.parseMove("e1g1", true));
+    Move killers[2] = {killer, Move()};
+    REQUIRE( !ttMove.isNull() );
+    REQUIRE( !killer.isNull() );
+
+    MovePicker picker(board, ttMove, killers);
+    REQUIRE( picker.next() == ttMove );
+
+    // captures next, until the killer shows up
+    Move move = picker.next();
+    while(move.isCapture()){
+        move = picker.next();
+    }
+    REQUIRE( move == killer );
+    REQUIRE( picker.stage() == STAGE_KILLER_2 );
+}
+
+TEST_CASE( "move picker skips hints that are not legal here", "[movepicker]" ) {
+
+    Board board;
+    board.setStartPos();
+
+    Move illegal(4, 36);                        // e1e5
+    Move killers[2] = {Move(12, 36), illegal};  // e2e5, e1e5
+
+    MovePicker picker(board, Move(8, 40), killers, Move(1, 11));
+    std::vector<uint16_t> picked = pickAll(picker);
+    REQUIRE( picked.size() == 20 );
+}
@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+#include "src/core/board.hpp"
+#include "src/core/perft.hpp"
+
+// Test 1: every standard perft position matches its known counts (kept to about a million leaves)
+// Test 2: castling rights follow the rook that moved or was captured
+// Test 3: promotions generate all four pieces and parse the piece suffix
+// Test 4: legal generation handles pins, double check and the en passant rank pin
+
+TEST_CASE( "perft suite matches the published node counts", "[perft]" ) {
+
+    for(int i = 0; i < PERFT_SUITE_SIZE; i++){
+        const PerftPosition& pos = PERFT_SUITE[i];
+        Board board;
+        REQUIRE( board.fromFEN(pos.fen) == FEN_OK );
+
+        for(int depth = 1; depth <= pos.depths && pos.nodes[depth - 1] <= 1000000; depth++){
+            INFO( pos.name << " depth " << depth );
+            REQUIRE( perft(board, depth) == pos.nodes[depth - 1] );
+        }
+    }
+}
+
+TEST_CASE( "moving or capturing a rook clears only its own castling right", "[perft]" ) {
+
+    Board board;
+    REQUIRE( board.fromFEN("rn2k1nr/8/8/8/8/8/8/R3K2R w KQkq - 0 1") == FEN_OK );
+
+    Move move = board.findMatchingMove(board.generateLegalMoves(), board.parseMove("a1a8", true));
+    REQUIRE( move.isCapture() );
+    board.makeMove(move);
+    REQUIRE( board.toFEN() == "Rn2k1nr/8/8/8/8/8/8/4K2R b Kk - 0 1" );
+
+    move = board.findMatchingMove(board.generateLegalMoves(), board.parseMove("h8h1", true));
+    REQUIRE( move.isCapture() );
+    board.makeMove(move);
+    REQUIRE( board.toFEN() == "Rn2k1n1/8/8/8/8/8/8/4K2r w - - 0 2" );
+}
+
+TEST_CASE( "promotions generate every piece and parse the piece suffix", "[perft]" ) {
+
+    Board board;
+    REQUIRE( board.fromFEN("8/P6k/8/8/8/8/8/K7 w - - 0 1") == FEN_OK );
+    MoveList moves = board.generateLegalMoves();
+
+    int promotions = 0;
+    for(const Move& move : moves){
+        if(move.isPromotion()) promotions++;
+    }
+    REQUIRE( promotions == 4 );
+
+    Move knight = board.findMatchingMove(moves, board.parseMove("a7a8n", true));
+    REQUIRE( knight.promotionType() == KNIGHT );
+    REQUIRE( knight.toString() == "a7a8n" );
+
+    Move queen = board.findMatchingMove(moves, board.parseMove("a7a8", true));
+    REQUIRE( queen.promotionType() == QUEEN );
+
+    board.makeMove(knight);
+    REQUIRE( board.squares[56] == W_KNIGHT );
+}
+
+static bool hasMove(const Board& board, const std::string& text){
+    for(const Move& move : board.generateLegalMoves()){
+        if(move.toString() == text) return true;
+    }
+    return false;
+}
+
+TEST_CASE( "legal generator respects pins, checks and en passant", "[perft]" ) {
+
+    Board board;
+
+    // bishop pinned on the e-file may not move, the rook may slide along the pin
+    REQUIRE( board.fromFEN("4r1k1/8/8/8/4B3/8/8/4K3 w - - 0 1") == FEN_OK );
+    REQUIRE( !hasMove(board, "e4d5") );
+    REQUIRE( board.fromFEN("4r1k1/8/8/8/8/8/4R3/4K3 w - - 0 1") == FEN_OK );
+    REQUIRE( hasMove(board, "e2e8") );
+    REQUIRE( !hasMove(board, "e2d2") );
+
+    // double check: only king moves
+    REQUIRE( board.fromFEN("4k3/8/8/8/1b6/8/3N4/r3K3 w - - 0 1") == FEN_OK );
+    for(const Move& move : board.generateLegalMoves()){
+        REQUIRE( move.from() == 4 );
+    }
+
+    // taking en passant would expose the king along the fifth rank
+    REQUIRE( board.fromFEN("8/8/8/K2pP2r/8/8/8/7k w - d6 0 1") == FEN_OK );
+    REQUIRE( !hasMove(board, "e5d6") );
+
+    // but it is the way out of a check given by the pushed pawn
+    REQUIRE( board.fromFEN("8/8/8/2k5/3pP3/8/8/4K3 b - e3 0 1") == FEN_OK );
+    REQUIRE( hasMove(board, "d4e3") );
+}
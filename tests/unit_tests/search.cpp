@@ -0,0 +1,182 @@
+#include <catch2/catch_test_macros.hpp>
+#include "src/core/board.hpp"
+#include "src/engine/engine.hpp"
+#include <cstdlib>
+
+// Test 1: a mate in one is played and scored as a mate one ply from the root
+// Test 2: the principal variation starts with the best move and is legal move by move
+// Test 3: shallow pruning cuts nodes but still finds the quiet winning move with the same score
+// Test 4: the mate search stops at the first iteration that proves a forced mate
+// Test 5: a quiet winning move is still found with late moves reduced, in fewer nodes
+//         than with reductions off
+// Test 6: a search leaves killers and history behind for move ordering
+// Test 7: a four thread search returns a legal move, a legal principal variation and
+//         table statistics summed over the threads
+
+
+TEST_CASE( "search scores a mate in one", "[search]" ) {
+
+    Board board;
+    REQUIRE( board.fromFEN("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1") == FEN_OK );
+    ChessEngine engine(EngineLevel::EXPERT);
+
+    Move best = engine.getBestMove(board, 4, 60000);
+    REQUIRE( best.toString() == "a1a8" );
+    REQUIRE( engine.getLastEvaluation() == mateIn(1) );
+    REQUIRE( mateInMoves(engine.getLastEvaluation()) == 1 );
+}
+
+TEST_CASE( "principal variation is a legal line", "[search]" ) {
+
+    Board board;
+    REQUIRE( board.fromFEN("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1") == FEN_OK );
+    ChessEngine engine(EngineLevel::EXPERT);
+
+    Move best = engine.getBestMove(board, 5, 60000);
+    const std::vector<Move>& pv = engine.getPrincipalVariation();
+    REQUIRE( !pv.empty() );
+    REQUIRE( pv[0] == best );
+
+    for(const Move& move : pv){
+        MoveList legal = board.generateLegalMoves();
+        bool found = false;
+        for(const Move& candidate : legal){
+            if(candidate == move) found = true;
+        }
+        REQUIRE( found );
+        board.makeMove(move);
+    }
+}
+
+TEST_CASE( "shallow pruning keeps a quiet winning move", "[search]" ) {
+
+    // the quiet rook lift Rg3 is the only win, a quiet move at every node below the root
+    // is a candidate for futility and late-move pruning
+    Board board;
+    REQUIRE( board.fromFEN("5rk1/1ppb3p/p1pb4/6q1/3P1p1r/2P1R2P/PP1BQ1P1/5RKN w - - 0 1") == FEN_OK );
+
+    ChessEngine full(EngineLevel::EXPERT);
+    PruningParams off;
+    off.reverseFutilityDepth = 0;
+    off.futilityDepth = 0;
+    off.lateMoveDepth = 0;
+    full.setPruningParams(off);
+    REQUIRE( full.getPruningParams().futilityDepth == 0 );
+    REQUIRE( full.getBestMove(board, 6, 60000).toString() == "e3g3" );
+
+    ChessEngine pruned(EngineLevel::EXPERT);
+    REQUIRE( pruned.getPruningParams().futilityDepth > 0 );
+    REQUIRE( pruned.getBestMove(board, 6, 60000).toString() == "e3g3" );
+    REQUIRE( pruned.getLastEvaluation() == full.getLastEvaluation() );
+    REQUIRE( pruned.getNodesSearched() < full.getNodesSearched() );
+}
+
+TEST_CASE( "mate search stops once the mate is proven", "[search]" ) {
+
+    Board board;
+    REQUIRE( board.fromFEN("7k/8/8/8/8/8/R7/1R4K1 w - - 0 1") == FEN_OK );
+    ChessEngine engine(EngineLevel::EXPERT);
+    engine.setMateSearch(true);
+
+    Move best = engine.getBestMove(board, 30, 60000);
+    REQUIRE( !best.isNull() );
+    REQUIRE( engine.getLastEvaluation() == mateIn(3) );
+    REQUIRE( mateInMoves(engine.getLastEvaluation()) == 2 );
+    REQUIRE( engine.getLastDepth() < 30 );
+
+    // the proven line ends in mate
+    for(const Move& move : engine.getPrincipalVariation()){
+        board.makeMove(move);
+    }
+    REQUIRE( board.isCheckmate() );
+}
+
+TEST_CASE( "late move reductions keep a quiet tactic", "[search]" ) {
+
+    // from the WAC suite: the quiet rook lift Rg3 wins, a late quiet move LMR reduces
+    Board board;
+    REQUIRE( board.fromFEN("5rk1/1ppb3p/p1pb4/6q1/3P1p1r/2P1R2P/PP1BQ1P1/5RKN w - - 0 1") == FEN_OK );
+
+    ChessEngine full(EngineLevel::EXPERT);
+    PruningParams noReductions;
+    noReductions.lateMoveReductions = false;
+    full.setPruningParams(noReductions);
+    REQUIRE( full.getBestMove(board, 8, 60000).toString() == "e3g3" );
+
+    ChessEngine reduced(EngineLevel::EXPERT);
+    REQUIRE( reduced.getPruningParams().lateMoveReductions );
+    REQUIRE( reduced.getBestMove(board, 8, 60000).toString() == "e3g3" );
+    REQUIRE( reduced.getLastDepth() == 8 );
+    REQUIRE( reduced.getLastEvaluation() > 100 );
+
+    // same answer from a smaller tree, so reductions did happen and were re-searched
+    // where they had to be
+    REQUIRE( reduced.getLastEvaluation() == full.getLastEvaluation() );
+    REQUIRE( reduced.getNodesSearched() < full.getNodesSearched() );
+}
+
+TEST_CASE( "search fills killers and history", "[search]" ) {
+
+    Board board;
+    board.setStartPos();
+    ChessEngine engine(EngineLevel::EXPERT);
+    engine.getBestMove(board, 6, 60000);
+
+    const SearchThread& main = engine.getSearchThreads()[0];
+    int killers = 0;
+    for(int ply = 0; ply <= MAX_PLY; ply++){
+        if(!main.killers[ply][0].isNull()) killers++;
+    }
+    REQUIRE( killers > 0 );
+
+    int scored = 0;
+    for(int side = 0; side < 2; side++){
+        for(int from = 0; from < 64; from++){
+            for(int to = 0; to < 64; to++){
+                if(main.history[side][from][to] != 0) scored++;
+            }
+        }
+    }
+    REQUIRE( scored > 0 );
+
+    // history stays inside the gravity bound
+    for(int from = 0; from < 64; from++){
+        for(int to = 0; to < 64; to++){
+            REQUIRE( std::abs(main.history[WHITE][from][to]) <= 16384 );
+        }
+    }
+}
+
+TEST_CASE( "multi-threaded search returns a legal move", "[search]" ) {
+
+    Board board;
+    REQUIRE( board.fromFEN("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1") == FEN_OK );
+    ChessEngine engine(EngineLevel::EXPERT);
+    engine.setThreads(4);
+    REQUIRE( engine.getThreads() == 4 );
+
+    Move best = engine.getBestMove(board, 6, 60000);
+    REQUIRE( engine.getSearchThreads().size() == 4 );
+    REQUIRE( engine.getTTHitRate() > 0.0 );
+    REQUIRE( engine.getTTHitRate() <= 1.0 );
+
+    MoveList legal = board.generateLegalMoves();
+    bool found = false;
+    for(const Move& candidate : legal){
+        if(candidate == best) found = true;
+    }
+    REQUIRE( found );
+
+    const std::vector<Move>& pv = engine.getPrincipalVariation();
+    REQUIRE( !pv.empty() );
+    REQUIRE( pv[0] == best );
+    for(const Move& move : pv){
+        MoveList moves = board.generateLegalMoves();
+        bool legalMove = false;
+        for(const Move& candidate : moves){
+            if(candidate == move) legalMove = true;
+        }
+        REQUIRE( legalMove );
+        board.makeMove(move);
+    }
+}
@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+#include "src/core/board.hpp"
+#include "src/engine/see.hpp"
+
+// Test 1: an undefended pawn is a clean win for the rook
+// Test 2: a defended pawn loses the knight that takes it
+// Test 3: the rook behind the capturer (x-ray) turns a losing exchange into a win
+
+
+static Move boardMove(Board& board, const std::string& text){
+    Move move = board.findMatchingMove(board.generateLegalMoves(), board.parseMove(text, true));
+    REQUIRE( !move.isNull() );
+    return move;
+}
+
+TEST_CASE( "see wins a hanging pawn", "[see]" ) {
+
+    Board board;
+    REQUIRE( board.fromFEN("1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1") == FEN_OK );
+    Move move = boardMove(board, "e1e5");
+
+    REQUIRE( see(board, move, 0) );
+    REQUIRE( see(board, move, 100) );
+    REQUIRE( !see(board, move, 101) );
+}
+
+TEST_CASE( "see loses a knight for a defended pawn", "[see]" ) {
+
+    Board board;
+    REQUIRE( board.fromFEN("1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1") == FEN_OK );
+    Move move = boardMove(board, "d3e5");
+
+    REQUIRE( !see(board, move, 0) );
+    REQUIRE( see(board, move, -220) );
+    REQUIRE( !see(board, move, -219) );
+}
+
+TEST_CASE( "see counts x-ray attackers", "[see]" ) {
+
+    Board board;
+    REQUIRE( board.fromFEN("3r2k1/8/8/3p4/8/8/3R4/3R2K1 w - - 0 1") == FEN_OK );
+    Move move = boardMove(board, "d2d5");
+
+    REQUIRE( see(board, move, 100) );
+    REQUIRE( !see(board, move, 101) );
+
+    // without the second rook the exchange loses the exchange
+    REQUIRE( board.fromFEN("3r2k1/8/8/3p4/8/8/3R4/6K1 w - - 0 1") == FEN_OK );
+    move = boardMove(board, "d2d5");
+    REQUIRE( !see(board, move, 0) );
+    REQUIRE( see(board, move, -400) );
+}
@@ -0,0 +1,68 @@
+#include <catch2/catch_test_macros.hpp>
+#include "src/engine/transposition.hpp"
+
+// Test 1: stored entries come back intact and unknown keys miss
+// Test 2: clear() empties the table
+// Test 3: a full bucket keeps deep entries and evicts the shallowest
+// Test 4: negative and mate scores survive the 16-bit packing and convert between plies
+
+
+TEST_CASE( "transposition table round-trips entries", "[tt]" ) {
+
+    TranspositionTable tt(1);
+    Move move(12, 28, DOUBLE_PAWN_PUSH);
+
+    tt.store(0x123456789ABCDEFULL, 42, 7, TT_LOWER, move);
+
+    TTData data;
+    REQUIRE( tt.probe(0x123456789ABCDEFULL, data) );
+    REQUIRE( data.move == move );
+    REQUIRE( data.score == 42 );
+    REQUIRE( data.depth == 7 );
+    REQUIRE( data.flag == TT_LOWER );
+
+    REQUIRE_FALSE( tt.probe(0x0FEDCBA987654321ULL, data) );
+
+    tt.clear();
+    REQUIRE_FALSE( tt.probe(0x123456789ABCDEFULL, data) );
+}
+
+TEST_CASE( "full buckets evict the shallowest entry", "[tt]" ) {
+
+    TranspositionTable tt(1);
+    TTData data;
+
+    // keys that differ only in the stored top bits share a bucket
+    const uint64_t base = 0x40ULL;
+    for(int i = 0; i < TTBucket::SIZE; i++){
+        tt.store(base + (static_cast<uint64_t>(i + 1) << 48), 0, 10 + i, TT_EXACT, Move());
+    }
+    tt.store(base + (99ULL << 48), 0, 20, TT_EXACT, Move());
+
+    REQUIRE_FALSE( tt.probe(base + (1ULL << 48), data) );
+    REQUIRE( tt.probe(base + (2ULL << 48), data) );
+    REQUIRE( tt.probe(base + (99ULL << 48), data) );
+    REQUIRE( data.depth == 20 );
+}
+
+TEST_CASE( "scores pack into entries and mates keep their distance", "[tt]" ) {
+
+    TranspositionTable tt(1);
+    TTData data;
+
+    tt.store(0xABCDULL << 48, -1234, 3, TT_UPPER, Move());
+    REQUIRE( tt.probe(0xABCDULL << 48, data) );
+    REQUIRE( data.score == -1234 );
+
+    // mate found 5 plies from the root, stored at ply 2 and read back at ply 4
+    Score mate = mateIn(5);
+    tt.store(0x1234ULL << 48, scoreToTT(mate, 2), 6, TT_EXACT, Move());
+    REQUIRE( tt.probe(0x1234ULL << 48, data) );
+    REQUIRE( scoreFromTT(data.score, 2) == mate );
+    REQUIRE( scoreFromTT(data.score, 4) == mateIn(7) );
+    REQUIRE( mateInMoves(mate) == 3 );
+
+    REQUIRE( scoreFromTT(scoreToTT(matedIn(4), 1), 1) == matedIn(4) );
+    REQUIRE( mateInMoves(matedIn(4)) == -2 );
+    REQUIRE( scoreToTT(250, 9) == 250 );
+}
@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+#include "src/core/board.hpp"
+
+// Test 1: hash covers side to move, castling rights and en passant file
+// Test 2: make/unmake keeps the incremental key equal to a full recompute
+// Test 3: transposed move orders reach the same key
+// Test 4: a null move flips the side, drops en passant and unmakes exactly
+
+static Move playMove(Board& board, const std::string& input){
+    Move move = board.findMatchingMove(board.generateLegalMoves(), board.parseMove(input, true));
+    REQUIRE( !move.isNull() );
+    board.makeMove(move);
+    return move;
+}
+
+
+TEST_CASE( "hash distinguishes side to move, castling rights and en passant", "[zobrist]" ) {
+
+    Board testBoard;
+    testBoard.setStartPos();
+    uint64_t startKey = testBoard.hashKey;
+
+    REQUIRE( startKey == testBoard.computeHash() );
+
+    testBoard.whiteToMove = false;
+    testBoard.refreshBitboards();
+    REQUIRE( testBoard.hashKey != startKey );
+
+    testBoard.setStartPos();
+    testBoard.castlingrights.W_QueenSide = false;
+    testBoard.refreshBitboards();
+    REQUIRE( testBoard.hashKey != startKey );
+
+    testBoard.setStartPos();
+    testBoard.enPassantSquare = 20;
+    testBoard.refreshBitboards();
+    REQUIRE( testBoard.hashKey != startKey );
+}
+
+TEST_CASE( "incremental hash matches a full recompute through make and unmake", "[zobrist]" ) {
+
+    Board testBoard;
+    testBoard.setStartPos();
+    uint64_t startKey = testBoard.hashKey;
+
+    // double push, capture, en passant, and castling
+    const char* line[] = {"e2e4", "d7d5", "e4e5", "f7f5", "e5f6", "g8f6", "g1f3", "b8c6", "f1c4", "c8g4", "e1g1"};
+    for(const char* input : line){
+        playMove(testBoard, input);
+        REQUIRE( testBoard.hashKey == testBoard.computeHash() );
+    }
+
+    // every legal reply makes and unmakes back to the same key
+    uint64_t key = testBoard.hashKey;
+    for(const Move& move : testBoard.generateLegalMoves()){
+        UndoInfo undo = testBoard.makeMove(move);
+        REQUIRE( testBoard.hashKey == testBoard.computeHash() );
+        testBoard.unmakeMove(move, undo);
+        REQUIRE( testBoard.hashKey == key );
+    }
+
+    REQUIRE( testBoard.hashKey != startKey );
+}
+
+TEST_CASE( "transpositions share a key", "[zobrist]" ) {
+
+    Board first;
+    first.setStartPos();
+    playMove(first, "g1f3");
+    playMove(first, "g8f6");
+    playMove(first, "b1c3");
+
+    Board second;
+    second.setStartPos();
+    playMove(second, "b1c3");
+    playMove(second, "g8f6");
+    playMove(second, "g1f3");
+
+    REQUIRE( first.hashKey == second.hashKey );
+}
+
+TEST_CASE( "null move passes the turn", "[zobrist]" ) {
+
+    Board board;
+    board.setStartPos();
+    playMove(board, "e2e4");
+    REQUIRE( board.enPassantSquare == 20 );
+    Board before = board;
+
+    UndoInfo undo = board.makeNullMove();
+    REQUIRE( board.whiteToMove );
+    REQUIRE( board.enPassantSquare == -1 );
+    REQUIRE( board.hashKey == board.computeHash() );
+
+    board.unmakeNullMove(undo);
+    REQUIRE( !board.whiteToMove );
+    REQUIRE( board.enPassantSquare == 20 );
+    REQUIRE( board.hashKey == before.hashKey );
+    REQUIRE( board.toFEN() == before.toFEN() );
+}